@@ -0,0 +1,151 @@
+#include "Alphabet.hpp"
+#include "config.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    /**
+     * @brief Fixed-size header of the alphabet file, followed by `symbols_count` symbol bytes in code order.
+     */
+    struct AlphabetFileHeader {
+        char magic[8];                  // ALPHABET_FILE_MAGIC
+        uint32_t version;               // ALPHABET_FILE_VERSION
+        uint32_t symbols_count;
+    };
+
+    const char ALPHABET_FILE_MAGIC[8] = { 'M', 'C', 'S', 'A', 'L', 'P', 'H', 'A' };
+    const uint32_t ALPHABET_FILE_VERSION = 1;
+}
+
+/**
+ * @brief Creates an alphabet of the given symbols (duplicates and the mask character are ignored).
+ */
+Alphabet::Alphabet(std::string_view symbols) {
+    codes.fill(UNMAPPED);
+
+    bool present[256] = {};
+    for (char symbol : symbols)
+        if (symbol != MASK) present[static_cast<unsigned char>(symbol)] = true;
+
+    for (int byte = 0; byte < 256 && symbols_list.size() < MAX_SYMBOLS; ++byte) {
+        if (!present[byte]) continue;
+        codes[byte] = static_cast<uint8_t>(symbols_list.size());
+        symbols_list.push_back(static_cast<char>(byte));
+    }
+}
+
+/**
+ * @brief Creates the alphabet of the generated texts, the letters `first`..`last`.
+ */
+Alphabet Alphabet::letters(char first, char last) {
+    std::string symbols;
+    for (char letter = first; letter <= last; ++letter) symbols.push_back(letter);
+    return Alphabet(symbols);
+}
+
+/**
+ * @brief Bits needed to pack one symbol code (at least 1).
+ */
+unsigned Alphabet::bits_per_symbol() const {
+    unsigned bits = 1;
+    while ((size_t(1) << bits) < symbols_list.size()) ++bits;
+    return bits;
+}
+
+/**
+ * @brief Checks that every character of the text is a symbol.
+ */
+bool Alphabet::encodes(std::string_view text) const {
+    for (char symbol : text)
+        if (code(symbol) == UNMAPPED) return false;
+    return true;
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of the symbols, ties saved trees to the alphabet they were built with.
+ */
+uint64_t Alphabet::checksum() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (char symbol : symbols_list) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Symbols as printable text, non-printable bytes escaped as \xNN.
+ */
+std::string Alphabet::printable() const {
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string result;
+    for (char symbol : symbols_list) {
+        unsigned char byte = static_cast<unsigned char>(symbol);
+        if (byte > ' ' && byte < 127 && byte != '\\') {
+            result.push_back(symbol);
+        }
+        else {
+            result += "\\x";
+            result.push_back(hex_digits[byte >> 4]);
+            result.push_back(hex_digits[byte & 15]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Saves the symbols to a binary alphabet file.
+ *
+ * @param filename The target filename.
+ * @return int 0 on success, -1 on failure.
+ */
+int Alphabet::save(const std::string& filename) const {
+    AlphabetFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ALPHABET_FILE_MAGIC, sizeof(header.magic));
+    header.version = ALPHABET_FILE_VERSION;
+    header.symbols_count = static_cast<uint32_t>(symbols_list.size());
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(symbols_list.data(), static_cast<std::streamsize>(symbols_list.size()));
+    if (!out) {
+        std::cerr << "[Alphabet] Failed to write file: " << filename << '\n';
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Loads the alphabet of the current text - Config::ALPHABET_FILENAME, or the letters
+ *        Config::Y_LETTER..'z' of the generated texts when that file does not exist.
+ *
+ * @param alphabet The alphabet to fill.
+ * @return int 0 on success, -1 if the alphabet file is corrupted.
+ */
+int Alphabet::load_current(Alphabet& alphabet) {
+    std::ifstream in(Config::ALPHABET_FILENAME, std::ios::binary);
+    if (!in) {
+        alphabet = letters(Config::Y_LETTER, 'z');
+        return 0;
+    }
+
+    AlphabetFileHeader header;
+    std::string symbols;
+    if (in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        std::memcmp(header.magic, ALPHABET_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == ALPHABET_FILE_VERSION && header.symbols_count > 0 && header.symbols_count <= MAX_SYMBOLS) {
+        symbols.resize(header.symbols_count);
+        in.read(&symbols[0], static_cast<std::streamsize>(symbols.size()));
+    }
+
+    Alphabet loaded(symbols);
+    if (!in || symbols.empty() || loaded.symbols() != symbols) {
+        std::cerr << "[Alphabet] Alphabet file is corrupted: " << Config::ALPHABET_FILENAME << '\n';
+        return -1;
+    }
+    alphabet = loaded;
+    return 0;
+}
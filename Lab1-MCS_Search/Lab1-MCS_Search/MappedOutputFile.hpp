@@ -0,0 +1,52 @@
+#ifndef MAPPED_OUTPUT_FILE_HPP
+#define MAPPED_OUTPUT_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Writable memory mapping of a new file of a known size (POSIX mmap / Windows file mapping).
+ *
+ * Lets several threads fill disjoint parts of a large output file in place, without
+ * building it in memory first. The contents reach the file when the mapping is closed.
+ */
+class MappedOutputFile {
+public:
+    MappedOutputFile() = default;
+    ~MappedOutputFile() { close(); }
+
+    MappedOutputFile(const MappedOutputFile&) = delete;
+    MappedOutputFile& operator=(const MappedOutputFile&) = delete;
+
+    /**
+     * @brief Creates (or truncates) the file with the given size and maps it for writing, closing any previous mapping first.
+     *
+     * @param filename The file to create.
+     * @param size The size of the file in bytes (must be > 0).
+     * @return int 0 on success, -1 on failure (file error, out of disk space, mapping error).
+     */
+    int create(const std::string& filename, size_t size);
+
+    /**
+     * @brief Writes the mapped pages back to the file, then unmaps and closes it. Safe to call when nothing is mapped.
+     *
+     * @return int 0 on success, -1 if writing the mapped pages back failed.
+     */
+    int close();
+
+    char* data() { return mapped_data; }
+    size_t size() const { return mapped_size; }
+    bool is_open() const { return mapped_data != nullptr; }
+
+private:
+    char* mapped_data = nullptr;
+    size_t mapped_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "MatchAccumulator.hpp"
+#include "WorkStealingScheduler.hpp"
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+MatchAccumulator::MatchAccumulator(const vector<string>& search_words)
+    : search_words(search_words), word_ids(search_words.size()), positions(search_words.size()) {
+    // Order the words once, equal words get the id of the first of them
+    vector<uint32_t> order(search_words.size());
+    iota(order.begin(), order.end(), 0u);
+    stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return search_words[a] < search_words[b]; });
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && search_words[order[i]] == search_words[order[i - 1]]) {
+            word_ids[order[i]] = word_ids[order[i - 1]];
+            continue;
+        }
+        word_ids[order[i]] = order[i];
+        ordered_ids.push_back(order[i]);
+    }
+}
+
+/**
+ * @brief Records every hit of a buffer and empties it.
+ */
+void MatchAccumulator::add_hits(vector<WordHit>& hits) {
+    for (const WordHit& hit : hits)
+        add(hit.word_index, hit.position);
+    vector<WordHit>().swap(hits);
+}
+
+/**
+ * @brief Sorts and deduplicates the positions of every word and appends the matches to `results` in word order.
+ *
+ * @param threads_count Number of threads to sort on.
+ * @param results The vector to append the matches to.
+ * @return size_t Number of distinct (word, position) matches.
+ */
+size_t MatchAccumulator::finish(unsigned threads_count, vector<WordMatch>& results) {
+    WorkStealingScheduler scheduler(threads_count);
+    scheduler.run(ordered_ids.size(), [&](unsigned, size_t i) {
+        vector<Config::TextPosition>& list = positions[ordered_ids[i]];
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+    });
+
+    size_t matches_count = 0;
+    for (uint32_t id : ordered_ids) {
+        vector<Config::TextPosition>& list = positions[id];
+        if (list.empty()) continue;
+
+        matches_count += list.size();
+        results.push_back(WordMatch{ id, PositionList(list.begin(), list.end()) });
+        vector<Config::TextPosition>().swap(list);
+    }
+    return matches_count;
+}
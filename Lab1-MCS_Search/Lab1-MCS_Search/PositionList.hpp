@@ -0,0 +1,112 @@
+#ifndef POSITION_LIST_HPP
+#define POSITION_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "config.hpp"
+
+/**
+ * @brief Sorted list of text positions (Config::TextPosition) with inline storage for the first few entries.
+ *
+ * Most words and filter keys have only a handful of positions, so up to INLINE_CAPACITY
+ * of them live inside the object (16 bytes in total with 32-bit positions) and the list
+ * only allocates when it grows past that. Positions are expected to be appended in increasing order.
+ */
+class PositionList {
+public:
+    static constexpr uint32_t INLINE_CAPACITY = 2;
+
+    PositionList() = default;
+
+    template <typename Iterator>
+    PositionList(Iterator begin, Iterator end) {
+        reserve(static_cast<uint32_t>(std::distance(begin, end)));
+        for (; begin != end; ++begin)
+            push_back(static_cast<Config::TextPosition>(*begin));
+    }
+
+    PositionList(const PositionList& other) : PositionList(other.begin(), other.end()) {}
+
+    PositionList(PositionList&& other) noexcept {
+        steal(other);
+    }
+
+    PositionList& operator=(const PositionList& other) {
+        if (this != &other) {
+            PositionList copy(other);
+            release();
+            steal(copy);
+        }
+        return *this;
+    }
+
+    PositionList& operator=(PositionList&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~PositionList() {
+        release();
+    }
+
+    /**
+     * @brief Appends a position, skipping it when it equals the last one.
+     */
+    void push_back(Config::TextPosition position) {
+        if (count > 0 && data()[count - 1] == position) return;
+        if (count == capacity) reserve(capacity * 2);
+        data()[count++] = position;
+    }
+
+    /**
+     * @brief Makes room for at least `new_capacity` positions.
+     */
+    void reserve(uint32_t new_capacity) {
+        if (new_capacity <= capacity) return;
+
+        Config::TextPosition* items = new Config::TextPosition[new_capacity];
+        if (count > 0) memcpy(items, data(), count * sizeof(Config::TextPosition));
+        if (capacity > INLINE_CAPACITY) delete[] storage.heap;
+        storage.heap = items;
+        capacity = new_capacity;
+    }
+
+    Config::TextPosition* data() { return capacity > INLINE_CAPACITY ? storage.heap : storage.items; }
+    const Config::TextPosition* data() const { return capacity > INLINE_CAPACITY ? storage.heap : storage.items; }
+    const Config::TextPosition* begin() const { return data(); }
+    const Config::TextPosition* end() const { return data() + count; }
+    Config::TextPosition operator[](size_t i) const { return data()[i]; }
+    Config::TextPosition back() const { return data()[count - 1]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    void release() {
+        if (capacity > INLINE_CAPACITY) delete[] storage.heap;
+        count = 0;
+        capacity = INLINE_CAPACITY;
+    }
+
+    void steal(PositionList& other) {
+        count = other.count;
+        capacity = other.capacity;
+        storage = other.storage;
+        other.count = 0;
+        other.capacity = INLINE_CAPACITY;
+    }
+
+    uint32_t count = 0;
+    uint32_t capacity = INLINE_CAPACITY;
+    union {
+        Config::TextPosition items[INLINE_CAPACITY];
+        Config::TextPosition* heap;
+    } storage;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "ResultWriter.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+ResultWriter::ResultWriter(size_t buffer_size, bool background)
+    : buffer_size(max<size_t>(64, buffer_size)), background(background) {
+    buffers[0] = static_cast<char*>(::operator new(this->buffer_size, align_val_t(BUFFER_ALIGNMENT)));
+    if (background) buffers[1] = static_cast<char*>(::operator new(this->buffer_size, align_val_t(BUFFER_ALIGNMENT)));
+    current = buffers[0];
+}
+
+ResultWriter::~ResultWriter() {
+    if (out.is_open()) close();
+    for (char* buffer : buffers) {
+        if (buffer != nullptr) ::operator delete(buffer, align_val_t(BUFFER_ALIGNMENT));
+    }
+}
+
+/**
+ * @brief Creates (or truncates) the file and starts the background flusher if enabled.
+ *
+ * @param filename The file to write.
+ * @param binary Flag indicating if the file is opened in binary mode (no newline translation).
+ * @return int 0 on success, -1 on failure.
+ */
+int ResultWriter::open(const string& filename, bool binary) {
+    if (out.is_open()) close();
+
+    out.open(filename, binary ? ios::trunc | ios::binary : ios::trunc);
+    if (!out) return -1;
+
+    used = 0;
+    failed = false;
+    stopping = false;
+    if (background) flusher = thread(&ResultWriter::flusher_loop, this);
+    return 0;
+}
+
+/**
+ * @brief Appends raw characters.
+ */
+void ResultWriter::write(string_view chars) {
+    while (!chars.empty()) {
+        if (used == buffer_size) flush_buffer();
+
+        size_t count = min(chars.size(), buffer_size - used);
+        memcpy(current + used, chars.data(), count);
+        used += count;
+        chars.remove_prefix(count);
+    }
+}
+
+/**
+ * @brief Appends the decimal representation of a number.
+ */
+void ResultWriter::write_number(uint64_t value) {
+    // 20 digits is the longest 64-bit number
+    if (buffer_size - used < 20) flush_buffer();
+
+    to_chars_result result = to_chars(current + used, current + buffer_size, value);
+    used = static_cast<size_t>(result.ptr - current);
+}
+
+/**
+ * @brief Appends a match in the results format: "Word: <word>\nPositions: <p1>, <p2>, ...\n\n".
+ */
+void ResultWriter::write_match(string_view word, const PositionList& positions) {
+    write("Word: ");
+    write(word);
+    write("\nPositions: ");
+
+    bool first = true;
+    for (Config::TextPosition pos : positions) {
+        if (!first) write(", ");
+        write_number(pos);
+        first = false;
+    }
+    write("\n\n");
+}
+
+/**
+ * @brief Writes the remaining data, stops the flusher and closes the file.
+ *
+ * @return int 0 if everything reached the file, -1 on a write failure.
+ */
+int ResultWriter::close() {
+    if (!out.is_open()) return -1;
+
+    if (used > 0) flush_buffer();
+
+    if (background) {
+        {
+            lock_guard<std::mutex> lock(flush_mutex);
+            stopping = true;
+        }
+        flush_condition.notify_all();
+        flusher.join();
+    }
+
+    out.close();
+    if (!out) failed = true;
+    return failed ? -1 : 0;
+}
+
+/**
+ * @brief Passes the filled part of the current buffer to the file and starts an empty buffer.
+ *
+ * In background mode this waits only until the flusher has taken the previous buffer,
+ * then continues filling the other one while the flusher writes.
+ */
+void ResultWriter::flush_buffer() {
+    if (!background) {
+        write_to_file(current, used);
+        used = 0;
+        return;
+    }
+
+    {
+        unique_lock<std::mutex> lock(flush_mutex);
+        flush_condition.wait(lock, [this] { return pending == nullptr; });
+        pending = current;
+        pending_size = used;
+    }
+    flush_condition.notify_all();
+
+    current = current == buffers[0] ? buffers[1] : buffers[0];
+    used = 0;
+}
+
+/**
+ * @brief Writes a block with one call, remembering a failure for close().
+ */
+void ResultWriter::write_to_file(const char* data, size_t size) {
+    if (size == 0 || failed) return;
+
+    out.write(data, static_cast<streamsize>(size));
+    if (!out) failed = true;
+}
+
+/**
+ * @brief Background thread body - writes every handed-over buffer until close() stops it.
+ */
+void ResultWriter::flusher_loop() {
+    unique_lock<std::mutex> lock(flush_mutex);
+    while (true) {
+        flush_condition.wait(lock, [this] { return pending != nullptr || stopping; });
+        if (pending == nullptr) break; // Stopping with nothing left to write
+
+        const char* data = pending;
+        size_t size = pending_size;
+        lock.unlock();
+        write_to_file(data, size);
+        lock.lock();
+
+        pending = nullptr;
+        flush_condition.notify_all();
+    }
+}
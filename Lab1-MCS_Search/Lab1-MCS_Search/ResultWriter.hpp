@@ -0,0 +1,91 @@
+#ifndef RESULT_WRITER_HPP
+#define RESULT_WRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "WordMatch.hpp"
+
+/**
+ * @brief Streams formatted results to a file through large aligned buffers.
+ *
+ * Text is appended straight into the current buffer (numbers with std::to_chars), and a
+ * full buffer is written with a single call. With a background flusher the file is written
+ * by a second thread while the next buffer is being filled, so formatting and I/O overlap.
+ */
+class ResultWriter {
+public:
+    static constexpr size_t BUFFER_ALIGNMENT = 4096;
+
+    /**
+     * @param buffer_size Size of each buffer in bytes (at least 64).
+     * @param background Flag indicating if full buffers are written by a background thread.
+     */
+    explicit ResultWriter(size_t buffer_size, bool background);
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /**
+     * @brief Creates (or truncates) the file and starts the background flusher if enabled.
+     *
+     * @param filename The file to write.
+     * @param binary Flag indicating if the file is opened in binary mode (no newline translation).
+     * @return int 0 on success, -1 on failure.
+     */
+    int open(const std::string& filename, bool binary = false);
+
+    /**
+     * @brief Appends raw characters.
+     */
+    void write(std::string_view chars);
+
+    /**
+     * @brief Appends the decimal representation of a number.
+     */
+    void write_number(uint64_t value);
+
+    /**
+     * @brief Appends a match in the results format: "Word: <word>\nPositions: <p1>, <p2>, ...\n\n".
+     */
+    void write_match(std::string_view word, const PositionList& positions);
+
+    /**
+     * @brief Writes the remaining data, stops the flusher and closes the file.
+     *
+     * @return int 0 if everything reached the file, -1 on a write failure.
+     */
+    int close();
+
+private:
+    void flush_buffer();
+    void write_to_file(const char* data, size_t size);
+    void flusher_loop();
+
+    size_t buffer_size;
+    bool background;
+    char* buffers[2] = { nullptr, nullptr };
+    char* current = nullptr;
+    size_t used = 0;
+
+    std::ofstream out;
+    std::atomic<bool> failed{ false };
+
+    // Hand-over of one full buffer to the flusher thread
+    std::thread flusher;
+    std::mutex flush_mutex;
+    std::condition_variable flush_condition;
+    const char* pending = nullptr;
+    size_t pending_size = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "SearchInputLoader.hpp"
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+
+SearchInputLoader::SearchInputLoader(const string& text_filename, const string& words_filename, const string& filters_filename) {
+    // Inputs not cached yet are read in on their own threads, so a search only waits for what it needs
+    text_ready = async(launch::async, [this, text_filename] {
+        return DatasetCache::get_text(text_filename, text, false);
+    });
+
+    if (!filters_filename.empty()) {
+        filters_ready = async(launch::async, [this, filters_filename] {
+            return DatasetCache::get_lines(filters_filename, filters, false);
+        });
+    }
+
+    words_parser = thread(&SearchInputLoader::parse_words, this, words_filename);
+}
+
+SearchInputLoader::~SearchInputLoader() {
+    if (words_parser.joinable()) words_parser.join();
+    if (text_ready.valid()) text_ready.wait();
+    if (filters_ready.valid()) filters_ready.wait();
+}
+
+/**
+ * @brief Parser thread body - splits the mapped words file into batches of Config::WORD_BATCH_SIZE words.
+ *
+ * The mapping comes from the DatasetCache, so a later search maps nothing again, while the
+ * words are still parsed batch by batch and the first batch is searched right away.
+ * Empty lines are skipped and trailing carriage returns are removed, like read_lines_from_file.
+ */
+void SearchInputLoader::parse_words(string words_filename) {
+    shared_ptr<const MappedText> words_file;
+    if (DatasetCache::get_text(words_filename, words_file, false) == 0) {
+        const string_view all_words = words_file->text;
+        {
+            lock_guard<mutex> lock(words_mutex);
+            words_file_size = all_words.size();
+        }
+
+        string_view rest = all_words;
+        while (!rest.empty()) {
+            vector<string> batch;
+            batch.reserve(WORD_BATCH_SIZE);
+            while (!rest.empty() && batch.size() < WORD_BATCH_SIZE) {
+                size_t line_end = rest.find('\n');
+                string_view line = rest.substr(0, line_end);
+                rest = line_end == string_view::npos ? string_view() : rest.substr(line_end + 1);
+
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (!line.empty()) batch.emplace_back(line);
+            }
+            if (batch.empty()) continue;
+
+            {
+                lock_guard<mutex> lock(words_mutex);
+                word_batches.push_back(move(batch));
+            }
+            words_condition.notify_all();
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(words_mutex);
+        words_done = true;
+    }
+    words_condition.notify_all();
+}
+
+/**
+ * @brief Waits for the text. The view stays valid as long as the loader lives.
+ *
+ * @return int 0 on success, -1 if the text is missing or empty.
+ */
+int SearchInputLoader::wait_text(string_view& text_view) {
+    int status = text_ready.valid() ? text_ready.get() : (text ? 0 : -1);
+    text_view = text ? text->text : string_view();
+    return status;
+}
+
+/**
+ * @brief Waits for the MCS filters. The pointer stays valid as long as the loader lives.
+ *
+ * @return int 0 on success, -1 if the filters are missing or empty.
+ */
+int SearchInputLoader::wait_filters(const vector<string>*& filters_list) {
+    int status = filters_ready.valid() ? filters_ready.get() : (filters ? 0 : -1);
+    filters_list = filters.get();
+    return status;
+}
+
+/**
+ * @brief Waits for the next batch of search words, in file order.
+ *
+ * @param batch The vector to move the batch's words into (replaced).
+ * @return false once every batch has been handed out.
+ */
+bool SearchInputLoader::next_word_batch(vector<string>& batch) {
+    unique_lock<mutex> lock(words_mutex);
+    words_condition.wait(lock, [this] { return !word_batches.empty() || words_done; });
+    if (word_batches.empty()) return false;
+
+    batch = move(word_batches.front());
+    word_batches.pop_front();
+    return true;
+}
+
+/**
+ * @brief Waits for all remaining search words and appends them to `search_words`.
+ *
+ * @return int 0 on success, -1 if no search words were loaded at all.
+ */
+int SearchInputLoader::wait_all_words(vector<string>& search_words) {
+    vector<string> batch;
+    while (next_word_batch(batch)) {
+        for (string& word : batch)
+            search_words.push_back(move(word));
+    }
+    return search_words.empty() ? -1 : 0;
+}
+
+/**
+ * @brief Runs task(worker, word_index, word) for every search word, starting on each batch as soon as it is parsed.
+ *
+ * All batches run in one scheduler run: a worker that runs out of words pulls the next
+ * batch from the parser, so a slow tail of one batch does not hold up the next. The
+ * words are appended to `search_words` in file order once the run is over, and
+ * `word_index` is the index each word gets there.
+ *
+ * @param scheduler The scheduler to run the words on.
+ * @param search_words The vector the words are appended to.
+ * @param task The function to run for every word.
+ * @return int 0 on success, -1 if no search words were loaded at all.
+ */
+int SearchInputLoader::run_word_batches(WorkStealingScheduler& scheduler, vector<string>& search_words, const WordTask& task) {
+    vector<string> first_batch;
+    if (!next_word_batch(first_batch)) return search_words.empty() ? -1 : 0;
+
+    // Every word takes at least two bytes of the file, so the slots are allocated once and
+    // never move while the workers read them. Every batch but the last is full, so word i
+    // of the run is word i % WORD_BATCH_SIZE of batch i / WORD_BATCH_SIZE.
+    size_t file_size;
+    {
+        lock_guard<mutex> lock(words_mutex);
+        file_size = words_file_size;
+    }
+    vector<vector<string>> batches(((file_size + 1) / 2 + WORD_BATCH_SIZE - 1) / WORD_BATCH_SIZE + 1);
+    batches[0] = move(first_batch);
+    size_t batches_fed = 0;
+
+    // Progress in bytes of the words file searched, counted per word
+    Telemetry::ProgressCounter progress("Search words (bytes)", file_size);
+    const size_t first = search_words.size();
+
+    scheduler.run([&](size_t& tasks_count) {
+        if (batches_fed > 0 && !next_word_batch(batches[batches_fed])) return false;
+        tasks_count = batches[batches_fed++].size();
+        return true;
+    }, [&](unsigned worker, size_t i) {
+        const string& word = batches[i / WORD_BATCH_SIZE][i % WORD_BATCH_SIZE];
+        task(worker, first + i, word);
+        progress.add(word.size() + 1);
+    });
+    progress.set(file_size);
+
+    for (size_t batch = 0; batch < batches_fed; ++batch) {
+        for (string& word : batches[batch])
+            search_words.push_back(move(word));
+    }
+    return search_words.empty() ? -1 : 0;
+}
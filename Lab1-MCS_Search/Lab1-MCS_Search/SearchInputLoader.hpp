@@ -0,0 +1,105 @@
+#ifndef SEARCH_INPUT_LOADER_HPP
+#define SEARCH_INPUT_LOADER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "utils.hpp"
+#include "dataset_cache.hpp"
+#include "WorkStealingScheduler.hpp"
+
+/**
+ * @brief Loads the inputs of a search concurrently and hands the search words over in batches.
+ *
+ * The constructor starts three background jobs at once: the text, the MCS filters (if any)
+ * and the mapping of the search words file are fetched from the DatasetCache, which only
+ * reads files that are not cached yet or changed, and the mapped words are parsed into
+ * batches of Config::WORD_BATCH_SIZE words. A search waits only for the inputs it needs,
+ * and run_word_batches() starts on the first batch while the rest are still being parsed.
+ */
+class SearchInputLoader {
+public:
+    /**
+     * @param text_filename The text file to map.
+     * @param words_filename The search words file, one word per line.
+     * @param filters_filename The MCS filters file to load as well, or empty for none.
+     */
+    SearchInputLoader(const std::string& text_filename, const std::string& words_filename, const std::string& filters_filename = "");
+    ~SearchInputLoader();
+
+    SearchInputLoader(const SearchInputLoader&) = delete;
+    SearchInputLoader& operator=(const SearchInputLoader&) = delete;
+
+    /**
+     * @brief Waits for the text. The view stays valid as long as the loader lives.
+     *
+     * @return int 0 on success, -1 if the text is missing or empty.
+     */
+    int wait_text(std::string_view& text_view);
+
+    /**
+     * @brief Waits for the MCS filters. The pointer stays valid as long as the loader lives.
+     *
+     * @return int 0 on success, -1 if the filters are missing or empty.
+     */
+    int wait_filters(const std::vector<std::string>*& filters_list);
+
+    /**
+     * @brief Waits for the next batch of search words, in file order.
+     *
+     * @param batch The vector to move the batch's words into (replaced).
+     * @return false once every batch has been handed out.
+     */
+    bool next_word_batch(std::vector<std::string>& batch);
+
+    /**
+     * @brief Waits for all remaining search words and appends them to `search_words`.
+     *
+     * @return int 0 on success, -1 if no search words were loaded at all.
+     */
+    int wait_all_words(std::vector<std::string>& search_words);
+
+    typedef std::function<void(unsigned worker, size_t word_index, const std::string& word)> WordTask;
+
+    /**
+     * @brief Runs task(worker, word_index, word) for every search word, starting on each batch as soon as it is parsed.
+     *
+     * All batches run in one scheduler run: a worker that runs out of words pulls the next
+     * batch from the parser, so a slow tail of one batch does not hold up the next. The
+     * words are appended to `search_words` in file order once the run is over, and
+     * `word_index` is the index each word gets there.
+     *
+     * @param scheduler The scheduler to run the words on.
+     * @param search_words The vector the words are appended to.
+     * @param task The function to run for every word.
+     * @return int 0 on success, -1 if no search words were loaded at all.
+     */
+    int run_word_batches(WorkStealingScheduler& scheduler, std::vector<std::string>& search_words, const WordTask& task);
+
+private:
+    void parse_words(std::string words_filename);
+
+    std::shared_ptr<const Utils::MappedText> text;
+    std::shared_ptr<const std::vector<std::string>> filters;
+    std::future<int> text_ready;
+    std::future<int> filters_ready;
+
+    // Word batches, produced by the parser thread
+    std::thread words_parser;
+    std::mutex words_mutex;
+    std::condition_variable words_condition;
+    std::deque<std::vector<std::string>> word_batches;
+    bool words_done = false;
+    size_t words_file_size = 0;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef SUMMARY_HPP
 #define SUMMARY_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <set>
@@ -14,7 +15,7 @@ using std::set;
  */
 struct Summary {
     string search_type;
-    int matches_found = 0;
+    uint64_t matches_found = 0;
     double time_took = 0;
 
     /**
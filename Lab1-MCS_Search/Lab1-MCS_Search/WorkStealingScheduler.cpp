@@ -0,0 +1,217 @@
+#include "WorkStealingScheduler.hpp"
+#include "utils.hpp"
+#include <chrono>
+
+using namespace std;
+using namespace chrono;
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned threads_count)
+    : threads(max(1u, threads_count)), ranges(new WorkerRange[max(1u, threads_count)]), worker_stats(max(1u, threads_count)) {
+    for (unsigned worker = 0; worker < threads; ++worker)
+        pool.emplace_back(&WorkStealingScheduler::worker_loop, this, worker);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        stopping = true;
+    }
+    run_started.notify_all();
+    for (thread& worker : pool) worker.join();
+}
+
+/**
+ * @brief Pool thread body - waits for a run, works on it, reports back, until the scheduler is destroyed.
+ */
+void WorkStealingScheduler::worker_loop(unsigned worker) {
+    size_t runs_seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            run_started.wait(lock, [&] { return stopping || runs_started != runs_seen; });
+            if (stopping) return;
+            runs_seen = runs_started;
+        }
+
+        work(worker, *current_task, current_progress);
+
+        lock_guard<mutex> lock(pool_mutex);
+        if (--workers_running == 0) run_finished.notify_all();
+    }
+}
+
+/**
+ * @brief Takes the next task from the front of the worker's own range.
+ */
+bool WorkStealingScheduler::pop_own(unsigned worker, size_t& task) {
+    WorkerRange& range = ranges[worker];
+    lock_guard<mutex> lock(range.mutex);
+    if (range.begin == range.end) return false;
+
+    task = range.begin++;
+    return true;
+}
+
+/**
+ * @brief Moves the back half of the largest other range into the worker's range and takes its first task.
+ *
+ * @return false when no other worker has tasks left.
+ */
+bool WorkStealingScheduler::steal(unsigned worker, size_t& task) {
+    while (true) {
+        // Pick the victim with the most remaining tasks (sizes may be stale, checked again under lock)
+        unsigned victim = worker;
+        size_t victim_remaining = 0;
+        for (unsigned other = 0; other < threads; ++other) {
+            if (other == worker) continue;
+            lock_guard<mutex> lock(ranges[other].mutex);
+            size_t remaining = ranges[other].end - ranges[other].begin;
+            if (remaining > victim_remaining) {
+                victim = other;
+                victim_remaining = remaining;
+            }
+        }
+        if (victim == worker) return false;
+
+        size_t stolen_begin, stolen_end;
+        {
+            WorkerRange& range = ranges[victim];
+            lock_guard<mutex> lock(range.mutex);
+            if (range.begin == range.end) continue; // Drained meanwhile - look again
+
+            stolen_end = range.end;
+            stolen_begin = range.begin + (range.end - range.begin) / 2;
+            range.end = stolen_begin;
+        }
+
+        worker_stats[worker].steals++;
+        task = stolen_begin;
+
+        WorkerRange& own = ranges[worker];
+        lock_guard<mutex> lock(own.mutex);
+        own.begin = stolen_begin + 1;
+        own.end = stolen_end;
+        return true;
+    }
+}
+
+/**
+ * @brief Takes the next tasks from the feed of the run into the worker's range and takes its first task.
+ *
+ * @return false when the run has no feed or the feed has no tasks left, which means the run is over.
+ */
+bool WorkStealingScheduler::pull_feed(unsigned worker, size_t& task) {
+    if (!current_feed) return false;
+
+    lock_guard<mutex> lock(feed_mutex);
+    // Another worker may have fed new tasks while this one waited for the feed
+    if (steal(worker, task)) return true;
+
+    size_t tasks_count = 0;
+    while (!feed_done) {
+        if (!(*current_feed)(tasks_count)) {
+            feed_done = true;
+            break;
+        }
+        if (tasks_count == 0) continue;
+
+        task = tasks_fed;
+        WorkerRange& own = ranges[worker];
+        {
+            lock_guard<mutex> range_lock(own.mutex);
+            own.begin = tasks_fed + 1;
+            own.end = tasks_fed + tasks_count;
+        }
+        tasks_fed += tasks_count;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Worker loop - runs own tasks, then steals, then pulls from the feed until no work is left anywhere.
+ */
+void WorkStealingScheduler::work(unsigned worker, const Task& task, Telemetry::ProgressCounter* progress) {
+    WorkerStats& stats = worker_stats[worker];
+    auto start = steady_clock::now();
+    double busy_seconds = 0;
+
+    size_t task_index;
+    while (pop_own(worker, task_index) || steal(worker, task_index) || pull_feed(worker, task_index)) {
+        auto task_start = steady_clock::now();
+        task(worker, task_index);
+        busy_seconds += duration<double>(steady_clock::now() - task_start).count();
+        stats.tasks_run++;
+        if (progress) progress->add();
+    }
+
+    stats.busy_seconds += busy_seconds;
+    stats.idle_seconds += duration<double>(steady_clock::now() - start).count() - busy_seconds;
+}
+
+/**
+ * @brief Runs task(worker, i) for every i in [0, tasks_count) and waits for all of them.
+ *
+ * @param tasks_count Number of tasks.
+ * @param task The function to run for every task index.
+ * @param show_progress Flag indicating if the tasks should be counted on a progress counter.
+ */
+void WorkStealingScheduler::run(size_t tasks_count, const Task& task, bool show_progress) {
+    // The workers bump the counter, the reporter thread prints it
+    unique_ptr<Telemetry::ProgressCounter> progress;
+    if (show_progress && tasks_count > 0) progress = make_unique<Telemetry::ProgressCounter>("Tasks", tasks_count);
+
+    for (unsigned worker = 0; worker < threads; ++worker) {
+        ranges[worker].begin = tasks_count * worker / threads;
+        ranges[worker].end = tasks_count * (worker + 1) / threads;
+    }
+
+    start_run(task, nullptr, progress.get());
+}
+
+/**
+ * @brief Runs task(worker, i) for tasks handed over by `feed` while the run goes on, and waits for all of them.
+ *
+ * @param feed The function handing over the next tasks.
+ * @param task The function to run for every task index.
+ */
+void WorkStealingScheduler::run(const TaskFeed& feed, const Task& task) {
+    for (unsigned worker = 0; worker < threads; ++worker) {
+        ranges[worker].begin = 0;
+        ranges[worker].end = 0;
+    }
+    feed_done = false;
+    tasks_fed = 0;
+
+    start_run(task, &feed, nullptr);
+}
+
+/**
+ * @brief Wakes the pool up on the prepared ranges and waits until every worker is done.
+ */
+void WorkStealingScheduler::start_run(const Task& task, const TaskFeed* feed, Telemetry::ProgressCounter* progress) {
+    current_task = &task;
+    current_feed = feed;
+    current_progress = progress;
+
+    unique_lock<mutex> lock(pool_mutex);
+    workers_running = threads;
+    runs_started++;
+    run_started.notify_all();
+    run_finished.wait(lock, [this] { return workers_running == 0; });
+}
+
+/**
+ * @brief Prints the busy/idle time and task counts of every worker over all run() calls.
+ *
+ * @param log_prefix Prefix of every printed line, e.g. "[NaiveSearch]".
+ */
+void WorkStealingScheduler::print_stats(const string& log_prefix) const {
+    for (unsigned worker = 0; worker < threads; ++worker) {
+        const WorkerStats& stats = worker_stats[worker];
+        ostringstream line;
+        line << log_prefix << " Worker " << worker << ": busy " << fixed << setprecision(3) << stats.busy_seconds
+             << "s, idle " << stats.idle_seconds << "s, " << stats.tasks_run << " tasks (" << stats.steals << " steals)\n";
+        cout << line.str();
+    }
+}
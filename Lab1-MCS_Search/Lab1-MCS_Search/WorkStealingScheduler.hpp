@@ -0,0 +1,122 @@
+#ifndef WORK_STEALING_SCHEDULER_HPP
+#define WORK_STEALING_SCHEDULER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "telemetry.hpp"
+
+/**
+ * @brief Busy/idle time and task counts of one scheduler worker, summed over all run() calls.
+ */
+struct WorkerStats {
+    double busy_seconds = 0;
+    double idle_seconds = 0;
+    size_t tasks_run = 0;
+    size_t steals = 0;
+};
+
+/**
+ * @brief Runs indexed tasks on a fixed number of threads, balancing uneven task costs by work stealing.
+ *
+ * Every worker starts with a contiguous range of task indices and takes tasks from its front.
+ * A worker whose range runs out steals the back half of the largest remaining range of
+ * another worker, so expensive tasks do not leave the other threads idle at the tail.
+ * The worker threads are started once and live as long as the scheduler, so a run() only
+ * wakes them up instead of spawning and joining a thread per worker.
+ */
+class WorkStealingScheduler {
+public:
+    typedef std::function<void(unsigned worker, size_t task)> Task;
+    typedef std::function<bool(size_t& tasks_count)> TaskFeed;
+
+    explicit WorkStealingScheduler(unsigned threads_count);
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    /**
+     * @brief Runs task(worker, i) for every i in [0, tasks_count) and waits for all of them.
+     *
+     * `worker` is the index of the running worker (below threads_count()), so tasks can keep
+     * per-worker state without locking.
+     *
+     * @param tasks_count Number of tasks.
+     * @param task The function to run for every task index.
+     * @param show_progress Flag indicating if the tasks should be counted on a progress counter.
+     */
+    void run(size_t tasks_count, const Task& task, bool show_progress = false);
+
+    /**
+     * @brief Runs task(worker, i) for tasks handed over by `feed` while the run goes on, and waits for all of them.
+     *
+     * A worker that finds nothing left to run or steal calls feed(tasks_count), one worker at
+     * a time, and may wait inside it until new tasks are ready. feed returns true with the
+     * number of new tasks, indexed right after the ones fed before, or false once there are no
+     * more. The new tasks go to the feeding worker's range, so the idle workers steal from it.
+     *
+     * @param feed The function handing over the next tasks.
+     * @param task The function to run for every task index.
+     */
+    void run(const TaskFeed& feed, const Task& task);
+
+    unsigned threads_count() const { return threads; }
+
+    /**
+     * @brief Per-worker statistics of all run() calls of this scheduler.
+     */
+    const std::vector<WorkerStats>& stats() const { return worker_stats; }
+
+    /**
+     * @brief Prints the busy/idle time and task counts of every worker over all run() calls.
+     *
+     * @param log_prefix Prefix of every printed line, e.g. "[NaiveSearch]".
+     */
+    void print_stats(const std::string& log_prefix) const;
+
+private:
+    struct alignas(64) WorkerRange {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    bool pop_own(unsigned worker, size_t& task);
+    bool steal(unsigned worker, size_t& task);
+    bool pull_feed(unsigned worker, size_t& task);
+    void start_run(const Task& task, const TaskFeed* feed, Telemetry::ProgressCounter* progress);
+    void work(unsigned worker, const Task& task, Telemetry::ProgressCounter* progress);
+    void worker_loop(unsigned worker);
+
+    unsigned threads;
+    std::unique_ptr<WorkerRange[]> ranges;
+    std::vector<WorkerStats> worker_stats;
+
+    // Worker pool, woken up by every run()
+    std::vector<std::thread> pool;
+    std::mutex pool_mutex;
+    std::condition_variable run_started;
+    std::condition_variable run_finished;
+    size_t runs_started = 0;
+    unsigned workers_running = 0;
+    bool stopping = false;
+
+    // The run in progress, set by run() before it wakes the workers
+    const Task* current_task = nullptr;
+    const TaskFeed* current_feed = nullptr;
+    Telemetry::ProgressCounter* current_progress = nullptr;
+
+    // Feeding of the run in progress, one worker at a time
+    std::mutex feed_mutex;
+    bool feed_done = false;
+    size_t tasks_fed = 0;
+};
+
+#endif
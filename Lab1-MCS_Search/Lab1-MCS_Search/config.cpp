@@ -10,8 +10,16 @@ namespace Config {
     void print_config() {
         cout << "================ Program Configuration ================\n";
         cout << "Text size                       : " << TEXT_SIZE << "\n";
+        cout << "Text_Position_Bits              : " << sizeof(TextPosition) * 8 << "\n";
         cout << "Number of Search Words          : " << NUMBER_OF_SEARCH_WORDS << "\n";
         cout << "Y-Letter                        : " << Y_LETTER << "\n";
+        cout << "Random_Text_Seed                : " << RANDOM_TEXT_SEED << (RANDOM_TEXT_SEED == 0 ? " (new every run)" : "") << "\n";
+        cout << "Text_Generation_Chunk_Size      : " << TEXT_GENERATION_CHUNK_SIZE << "\n";
+        cout << "Alphabet_Filename               : " << ALPHABET_FILENAME << "\n";
+        cout << "Corpus_Filename                 : " << CORPUS_FILENAME << "\n";
+        cout << "Corpus_Fold_Case                : " << (CORPUS_FOLD_CASE ? "yes" : "no") << "\n";
+        cout << "Corpus_Separators (bytes)       : " << CORPUS_SEPARATORS.size() << "\n";
+        cout << "Corpus_Header_Prefix            : " << (CORPUS_HEADER_PREFIX == '\0' ? string("none") : string(1, CORPUS_HEADER_PREFIX)) << "\n";
         cout << "Search_Word_Size (pattern)      : " << SEARCH_WORD_SIZE << "\n";
         cout << "Minimal_Matches (min hits)      : " << MINIMAL_MATCHES << "\n";
         cout << "Filter_Number_Of_Matches        : " << FILTER_NUMBER_OF_MATCHES << "\n";
@@ -23,10 +31,20 @@ namespace Config {
         cout << "Naive_Output_Filename           : " << NAIVE_SEARCH_OUTPUT_FILENAME << "\n";
         cout << "Standard_MCS_Output_Filename    : " << STANDARD_MCS_SEARCH_OUTPUT_FILENAME << "\n";
         cout << "Positional_MCS_Output_Filename  : " << POSITIONAL_MCS_SEARCH_OUTPUT_FILENAME << "\n";
+        cout << "Streaming_MCS_Output_Filename   : " << STREAMING_MCS_SEARCH_OUTPUT_FILENAME << "\n";
         cout << "Naive_Summary_Filename          : " << NAIVE_SEARCH_SUMMARY_FILENAME << "\n";
         cout << "Standard_MCS_Summary_Filename   : " << STANDARD_MCS_SEARCH_SUMMARY_FILENAME << "\n";
         cout << "Positional_MCS_Summary_Filename : " << POSITIONAL_MCS_SEARCH_SUMMARY_FILENAME << "\n";
+        cout << "Streaming_MCS_Summary_Filename  : " << STREAMING_MCS_SEARCH_SUMMARY_FILENAME << "\n";
         cout << "Combined_Summary_Filename       : " << COMBINED_SUMMARY_FILENAME << "\n";
+        cout << "Number_Of_Threads (0 = all)     : " << NUMBER_OF_THREADS << "\n";
+        cout << "Streaming_Chunk_Size (windows)  : " << STREAMING_CHUNK_SIZE << "\n";
+        cout << "Prefault_Mapped_Files           : " << (PREFAULT_MAPPED_FILES ? "yes" : "no") << "\n";
+        cout << "Word_Batch_Size                 : " << WORD_BATCH_SIZE << "\n";
+        cout << "Progress_Report_Interval_Ms     : " << PROGRESS_REPORT_INTERVAL_MS << "\n";
+        cout << "Result_Writer_Buffer_Size       : " << RESULT_WRITER_BUFFER_SIZE << "\n";
+        cout << "Save_Results_As_Text            : " << (SAVE_RESULTS_AS_TEXT ? "yes" : "no") << "\n";
+        cout << "Result_Writer_Background        : " << (RESULT_WRITER_BACKGROUND ? "yes" : "no") << "\n";
         cout << "=======================================================\n\n";
     }
 
@@ -36,8 +54,8 @@ namespace Config {
     void validate_config() {
         vector<string> errors;
 
-        const int minimumTextSize = 100000;
-        const int maxSearchWordSizeFactor = 6;
+        const uint64_t minimumTextSize = 100000;
+        const uint64_t maxSearchWordSizeFactor = 6;
 
         if (SEARCH_WORD_SIZE < MINIMAL_MATCHES) {
             errors.emplace_back("MINIMAL_MATCHES should be lower than SEARCH_WORD_SIZE");
@@ -55,7 +73,7 @@ namespace Config {
             errors.emplace_back("Y_LETTER should be a lowercase English letter");
         }
 
-        if ((SEARCH_WORD_SIZE * NUMBER_OF_SEARCH_WORDS) > (TEXT_SIZE * maxSearchWordSizeFactor)) {
+        if (static_cast<uint64_t>(SEARCH_WORD_SIZE) * NUMBER_OF_SEARCH_WORDS > TEXT_SIZE * maxSearchWordSizeFactor) {
             errors.emplace_back("SEARCH_WORD_SIZE * NUMBER_OF_SEARCH_WORDS should not exceed TEXT_SIZE * " + to_string(maxSearchWordSizeFactor));
         }
 
@@ -1,18 +1,28 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <vector>
+#include <type_traits>
 
 namespace Config {
 
-    const int TEXT_SIZE = 10000000; // 10 million characters
+    const uint64_t TEXT_SIZE = 10000000; // 10 million characters
+    typedef std::conditional<(TEXT_SIZE < UINT32_MAX), uint32_t, uint64_t>::type TextPosition; // Text positions are 32-bit while the text fits in them, 64-bit beyond
     const int NUMBER_OF_SEARCH_WORDS = 10000; // Number of search words (taken from the start of the text)
     const int SEARCH_WORD_SIZE = 21; // size of word for search
     const int MINIMAL_MATCHES = 15; // minimal number of matches
     const int FILTER_NUMBER_OF_MATCHES = 5; // number of matches in the filter
     const char Y_LETTER = 't'; // the start char the text is being generated from (up to z)
+    const uint64_t RANDOM_TEXT_SEED = 0; // Seed of the random text (0 for a new seed every run, the used seed is printed)
+    const size_t TEXT_GENERATION_CHUNK_SIZE = 4 * 1024 * 1024; // Characters generated per parallel task (multiple of 4)
+    const std::string ALPHABET_FILENAME = "alphabet.bin"; // Symbols of the current text; the streaming search packs their codes into keys
+    const std::string CORPUS_FILENAME = "corpus.txt"; // Real data read by Corpus Ingestion (FASTA, protein, logs...), encoded into the text file
+    const bool CORPUS_FOLD_CASE = true; // Fold upper-case corpus letters to lower case
+    const std::string CORPUS_SEPARATORS = " \t\r\n"; // Corpus bytes dropped from the text (a newline is always dropped, $ is refused)
+    const char CORPUS_HEADER_PREFIX = '>'; // Corpus lines starting with it are skipped, like FASTA headers ('\0' keeps every line)
     const std::string STANDARD_MCS_OUTPUT_FILENAME = "standard_mcs_output"; // Output file for mcs
     const std::string POSITIONAL_MCS_OUTPUT_FILENAME = "positional_mcs_output"; // Output file for positional mcs
     const std::string RANDOM_GENERATED_TEXT_FILENAME = "generated_text"; // Output file for random generated text
@@ -21,12 +31,29 @@ namespace Config {
     const std::string NAIVE_SEARCH_OUTPUT_FILENAME = "naive_output"; // Output file for naive search algorithm
     const std::string STANDARD_MCS_SEARCH_OUTPUT_FILENAME = "standard_mcs_search_output"; // Output file for standard MCS search algorithm
     const std::string POSITIONAL_MCS_SEARCH_OUTPUT_FILENAME = "positional_mcs_search_output"; // Output file for positional MCS search algorithm
+    const std::string STREAMING_MCS_SEARCH_OUTPUT_FILENAME = "streaming_mcs_search_output"; // Output file for streaming MCS search algorithm
     const std::string NAIVE_SEARCH_SUMMARY_FILENAME = "summary_naive"; // Output file for summary of Naive Search
     const std::string STANDARD_MCS_SEARCH_SUMMARY_FILENAME = "summary_standard_mcs"; // Output file for summary of Standard MCS Search
     const std::string POSITIONAL_MCS_SEARCH_SUMMARY_FILENAME = "summary_positional_mcs"; // Output file for summary of Positional MCS Search
+    const std::string STREAMING_MCS_SEARCH_SUMMARY_FILENAME = "summary_streaming_mcs"; // Output file for summary of Streaming MCS Search
+    const std::vector<std::string> SEARCH_OUTPUT_FILENAMES = {
+        NAIVE_SEARCH_OUTPUT_FILENAME,
+        STANDARD_MCS_SEARCH_OUTPUT_FILENAME,
+        POSITIONAL_MCS_SEARCH_OUTPUT_FILENAME,
+        STREAMING_MCS_SEARCH_OUTPUT_FILENAME
+    }; // Search results files that can be converted from binary to text
     const std::string COMBINED_SUMMARY_FILENAME = "summary_all"; // Output file for combined summary of all searches
 
-    const int PROGRESS_UPDATES_COUNT = 10000; // Used to control how often progress is updated during a loop
+    const unsigned NUMBER_OF_THREADS = 0; // Worker threads for the searches (0 for all hardware threads)
+    const size_t STREAMING_CHUNK_SIZE = 65536; // Text windows per task of the streaming MCS search
+
+    const bool PREFAULT_MAPPED_FILES = false; // Load all pages of mapped input files up front instead of on first touch
+    const size_t WORD_BATCH_SIZE = 1024; // Search words parsed per batch; a search starts on the first batch while the rest load
+    const size_t RESULT_WRITER_BUFFER_SIZE = 1024 * 1024; // Size of each buffer results are formatted into before one write call
+    const bool SAVE_RESULTS_AS_TEXT = false; // Also write search results as text (binary .bin results can be converted later from the menu)
+    const bool RESULT_WRITER_BACKGROUND = true; // Write full result buffers on a background thread while the next one is filled
+
+    const int PROGRESS_REPORT_INTERVAL_MS = 200; // How often the background reporter redraws the progress of running loops
     const std::vector<std::string> OPTIONS = {
         "MCS Creation",
         "Positional MCS Creation",
@@ -36,7 +63,10 @@ namespace Config {
         "Naive Search",
         "Standard MCS Search",
         "Positional MCS Search",
-        "Create Final Summary"
+        "Create Final Summary",
+        "Streaming MCS Search",
+        "Convert Results To Text",
+        "Corpus Ingestion"
     }; // List of choices for user
 
     /**
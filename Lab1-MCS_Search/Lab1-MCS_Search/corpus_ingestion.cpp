@@ -0,0 +1,149 @@
+#include "corpus_ingestion.hpp"
+#include <cstdio>
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+
+namespace CorpusIngestion {
+
+    static const size_t ENCODE_BUFFER_SIZE = 64 * 1024;
+
+    /**
+     * @brief Encodes a corpus into the text file and saves the alphabet of the text.
+     *
+     * Header lines and separators are dropped and letters are case-folded (see the CORPUS_*
+     * config), leaving one byte per symbol with no line structure. The symbols found get the
+     * dense codes of the alphabet, saved to ALPHABET_FILENAME, which the trees and packed keys
+     * size themselves by. The text stops at TEXT_SIZE symbols, so its positions fit TextPosition.
+     * A corpus holding Alphabet::MASK outside header lines and separators is refused.
+     *
+     * @param corpus_filename The corpus to read.
+     * @param alphabet Set to the alphabet of the text.
+     * @param stats Set to the counts of the ingestion.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled.
+     */
+    int ingest_corpus(const string& corpus_filename, Alphabet& alphabet, IngestionStats& stats) {
+        stats = IngestionStats();
+
+        MappedFile corpus;
+        if (corpus.open(corpus_filename, MappedFile::Access::SEQUENTIAL) != 0) {
+            cerr << "[CorpusIngestion] Failed to map corpus: " << corpus_filename << '\n';
+            return -1;
+        }
+        cout << "[CorpusIngestion] Encoding " << corpus_filename << " (" << corpus.size() << " bytes)...\n";
+
+        // === Byte tables: what every corpus byte becomes in the text ===
+        bool dropped[256] = {};
+        for (char separator : CORPUS_SEPARATORS) dropped[static_cast<unsigned char>(separator)] = true;
+        dropped[static_cast<unsigned char>('\n')] = true;
+
+        char folded[256];
+        for (int byte = 0; byte < 256; ++byte) {
+            folded[byte] = static_cast<char>(byte);
+            if (CORPUS_FOLD_CASE && byte >= 'A' && byte <= 'Z') folded[byte] = static_cast<char>(byte - 'A' + 'a');
+        }
+
+        ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+        int status = open_result_file(writer, RANDOM_GENERATED_TEXT_FILENAME);
+        if (status != 0) return status;
+
+        // === One pass: skip header lines, drop separators, fold, count the symbols ===
+        const char* data = corpus.data();
+        const size_t size = corpus.size();
+        const uint64_t max_text_size = TEXT_SIZE;
+        uint64_t symbol_counts[256] = {};
+        string buffer;
+        buffer.reserve(ENCODE_BUFFER_SIZE);
+        bool line_start = true;
+        bool in_header = false;
+
+        Telemetry::ProgressCounter progress("Corpus", size);
+        size_t i = 0;
+        for (; i < size; ++i) {
+            const unsigned char byte = static_cast<unsigned char>(data[i]);
+            if (line_start && CORPUS_HEADER_PREFIX != '\0' && byte == static_cast<unsigned char>(CORPUS_HEADER_PREFIX)) {
+                in_header = true;
+                stats.header_lines++;
+            }
+            line_start = byte == '\n';
+
+            if (in_header || dropped[byte]) {
+                if (line_start) in_header = false;
+                stats.dropped_bytes++;
+                continue;
+            }
+
+            // '$' is the mask symbol of the filtered keys, so the text can't hold it
+            if (byte == static_cast<unsigned char>(Alphabet::MASK)) {
+                cerr << "[CorpusIngestion] Corpus has '" << Alphabet::MASK << "' at byte " << i
+                     << ", which is reserved for masked positions - replace it or add it to CORPUS_SEPARATORS.\n";
+                writer.close();
+                remove(ensure_txt_extension(RANDOM_GENERATED_TEXT_FILENAME).c_str());
+                return -1;
+            }
+
+            if (stats.text_size == max_text_size) {
+                stats.truncated = true;
+                break;
+            }
+
+            const char symbol = folded[byte];
+            if (symbol != static_cast<char>(byte)) stats.folded_bytes++;
+            symbol_counts[static_cast<unsigned char>(symbol)]++;
+            buffer.push_back(symbol);
+            stats.text_size++;
+
+            if (buffer.size() == ENCODE_BUFFER_SIZE) {
+                writer.write(buffer);
+                buffer.clear();
+                progress.set(i + 1);
+            }
+        }
+        writer.write(buffer);
+        writer.write("\n");
+        stats.corpus_bytes = i;
+        progress.set(i);
+        progress.finish();
+
+        if (writer.close() != 0) {
+            cerr << "[CorpusIngestion] Failed to write file: " << RANDOM_GENERATED_TEXT_FILENAME << ".txt\n";
+            return -1;
+        }
+
+        if (stats.text_size < static_cast<uint64_t>(SEARCH_WORD_SIZE)) {
+            cerr << "[CorpusIngestion] Corpus has only " << stats.text_size << " symbols, fewer than SEARCH_WORD_SIZE.\n";
+            return -1;
+        }
+
+        // === Dense codes for the symbols that occur, in byte order ===
+        string symbols;
+        for (int byte = 0; byte < 256; ++byte)
+            if (symbol_counts[byte] > 0) symbols.push_back(static_cast<char>(byte));
+        alphabet = Alphabet(symbols);
+        if (alphabet.save(ALPHABET_FILENAME) != 0) return -1;
+
+        cout << "[CorpusIngestion] Text has " << stats.text_size << " symbols" << (stats.truncated ? " (stopped at TEXT_SIZE)" : "")
+             << ", dropped " << stats.dropped_bytes << " bytes (" << stats.header_lines << " header lines), folded " << stats.folded_bytes << ".\n";
+        cout << "[CorpusIngestion] Alphabet of " << alphabet.size() << " symbols: " << alphabet.printable() << '\n';
+        return 0;
+    }
+
+    /**
+     * @brief Ingests CORPUS_FILENAME into the text file.
+     *
+     * The search words are then taken from the encoded text by Search Words Creation.
+     *
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled.
+     */
+    int run_corpus_ingestion() {
+        Alphabet alphabet;
+        IngestionStats stats;
+        int status = ingest_corpus(CORPUS_FILENAME, alphabet, stats);
+        if (status != 0) return status;
+
+        cout << "[CorpusIngestion] Streaming search keys take " << alphabet.bits_per_symbol() << " bits per symbol.\n";
+        cout << "[CorpusIngestion] Corpus ingested - create the search words and the filters map to search it.\n";
+        return 0;
+    }
+}
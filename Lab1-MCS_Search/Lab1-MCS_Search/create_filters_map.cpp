@@ -19,7 +19,7 @@ namespace FiltersMap {
      *
      * @return A filtered string where the characters are either from the `word` or '_' depending on the filter.
      */
-    string apply_filter_to_word(const string& word, const string& filter, size_t sliding_window_index) {
+    string apply_filter_to_word(string_view word, const string& filter, size_t sliding_window_index) {
         size_t search_word_length = word.size();
         size_t filter_length = filter.size();
 
@@ -33,7 +33,7 @@ namespace FiltersMap {
         return filtered_word;
     }
 
-    unordered_map<string, WordMatch> filters_map;
+    unordered_map<string, PositionList> filters_map;
 
     /**
      * @brief Creates a map of filtered words and their positions in the input text.
@@ -48,25 +48,28 @@ namespace FiltersMap {
         cout << "[FiltersMapBuilder] Starting filters map creation...\n";
 
         // === Phase 1: Read files ===
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        shared_ptr<const MappedText> cached_text;
+        if (DatasetCache::get_text(RANDOM_GENERATED_TEXT_FILENAME, cached_text) != 0) {
             cerr << "[FiltersMapBuilder] Failed to load text.\n";
             return -1;
         }
+        string_view text = cached_text->text;
 
-        vector<string> filters = read_lines_from_file(STANDARD_MCS_OUTPUT_FILENAME);
-        if (filters.empty()) {
+        shared_ptr<const vector<string>> cached_filters;
+        if (DatasetCache::get_lines(STANDARD_MCS_OUTPUT_FILENAME, cached_filters) != 0) {
             cerr << "[FiltersMapBuilder] Failed to load MCS filters.\n";
             return -1;
         }
+        const vector<string>& filters = *cached_filters;
 
         // === Phase 2: Iterate through text ===
         filters_map.clear();
         size_t text_len = text.length();
         size_t total_iterations = text_len - SEARCH_WORD_SIZE + 1;
+        Telemetry::ProgressCounter progress("Filters map", total_iterations);
 
         for (size_t i = 0; i < total_iterations; ++i) {
-            string window = text.substr(i, SEARCH_WORD_SIZE);
+            string_view window = text.substr(i, SEARCH_WORD_SIZE);
 
             // === Phase 3: Create words from the window using each filter ===
             for (const string& filter : filters) {
@@ -75,31 +78,31 @@ namespace FiltersMap {
                 // === Phase 4: Update the map ===
                 size_t position = i + 1;
 
-                if (filters_map.find(filtered_word) == filters_map.end())
-                    filters_map[filtered_word] = WordMatch{ filtered_word, {position} };
-                else 
-                    filters_map[filtered_word].positions.insert(position);
+                filters_map[filtered_word].push_back(static_cast<TextPosition>(position));
             }
-            print_progress(static_cast<int>(i + 1), static_cast<int>(total_iterations));
+            progress.set(i + 1);
         }
+        progress.finish();
 
-        // === Phase 5: Convert to output lines and save to output file ===
+        // === Phase 5: Stream the map entries to the output file ===
         cout << "Should also save to file: " << FILTERS_MAP << "? (y/n)\n";
         int status = 0;
         char choice;
         cin >> choice;
         if (choice == 'y') {
-            vector<WordMatch> results;
-            size_t total = filters_map.size();
-            size_t i = 0;
-            cout << "[FiltersMapBuilder] Organising Data..\n";
-            for (const auto& pair : filters_map) {
-                results.push_back(pair.second);
-                print_progress(static_cast<int>(++i), static_cast<int>(total));
+            ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+            status = open_result_file(writer, FILTERS_MAP);
+            if (status == 0) {
+                Telemetry::ProgressCounter save_progress("Saving filters map", filters_map.size());
+                for (const auto& pair : filters_map) {
+                    writer.write_match(pair.first, pair.second);
+                    save_progress.add();
+                }
+                save_progress.finish();
+
+                status = writer.close();
+                if (status != 0) cerr << "[FiltersMapBuilder] Failed to write file: " << FILTERS_MAP << '\n';
             }
-
-            vector<string> lines = convert_matches_to_lines(results);
-            status = save_to_file(lines, FILTERS_MAP);
         }
 
         if (status == 0) cout << "[FiltersMapBuilder] Filters map creation complete.\n";
@@ -2,8 +2,9 @@
 #define CREATE_FILTERS_MAP_HPP
 
 #include "utils.hpp"
+#include "dataset_cache.hpp"
 #include "config.hpp"
-#include "WordMatch.hpp"
+#include "PositionList.hpp"
 
 #include <unordered_map>
 #include <vector>
@@ -11,7 +12,7 @@
 #include <iostream>
 
 namespace FiltersMap {
-    extern std::unordered_map<std::string, WordMatch> filters_map;
+    extern std::unordered_map<std::string, PositionList> filters_map;
 
 	/**
      * @brief Applies a binary filter to a given word and returns a filtered version of the word.
@@ -26,7 +27,7 @@ namespace FiltersMap {
      *
      * @return A filtered string where the characters are either from the `word` or '_' depending on the filter.
      */
-	string apply_filter_to_word(const string& word, const string& filter, size_t sliding_window_index);
+	string apply_filter_to_word(std::string_view word, const string& filter, size_t sliding_window_index);
 
     /**
      * @brief Creates a map of filtered words and their positions in the input text.
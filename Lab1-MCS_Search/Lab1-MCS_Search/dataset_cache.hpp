@@ -0,0 +1,48 @@
+#ifndef DATASET_CACHE_HPP
+#define DATASET_CACHE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace DatasetCache {
+
+    /**
+     * @brief Returns the contents of a text file, mapping it only when it is not cached yet or changed on disk.
+     *
+     * The mapping stays open for the rest of the session, so every menu operation after the
+     * first gets the text without any I/O, and the text is never copied - a multi-gigabyte
+     * text takes its size in memory once. A cached file is remapped when its size or
+     * modification time differs from when it was mapped, or after invalidate() was called
+     * for it. The program invalidates a file before rewriting it.
+     *
+     * @param filename Name of the file to read (".txt" is added if missing).
+     * @param text Set to the cached mapping on success, reset on failure.
+     * @param should_print_log Flag indicating if should print when the file is read from disk.
+     * @return int 0 on success, -1 if the file is missing or empty.
+     */
+    int get_text(const std::string& filename, std::shared_ptr<const Utils::MappedText>& text, bool should_print_log = true);
+
+    /**
+     * @brief Returns the non-empty lines of a file, parsing it only when it is not cached yet or changed on disk.
+     *
+     * Same caching rules as get_text(). Lines are split like Utils::read_lines_from_file.
+     *
+     * @param filename Name of the file to read (".txt" is added if missing).
+     * @param lines Set to the cached lines on success, reset on failure.
+     * @param should_print_log Flag indicating if should print when the file is read from disk.
+     * @return int 0 on success, -1 if the file is missing or has no lines.
+     */
+    int get_lines(const std::string& filename, std::shared_ptr<const std::vector<std::string>>& lines, bool should_print_log = true);
+
+    /**
+     * @brief Drops the cached contents of a file, so the next get reads it again.
+     *
+     * @param filename Name of the file (".txt" is added if missing).
+     */
+    void invalidate(const std::string& filename);
+}
+
+#endif
@@ -31,13 +31,13 @@ namespace FinalSummary {
                 summary.search_type = line.substr(12);  // Remove "Search Type: "
             }
             else if (line.find("Matches Found:") == 0) {
-                summary.matches_found = stoi(line.substr(14));  // Remove "Matches Found: "
+                summary.matches_found = stoull(line.substr(14));  // Remove "Matches Found: "
             }
             else if (line.find("Time took:") == 0) {
                 summary.time_took = stod(line.substr(11));  // Remove "Time took: "
             }
         }
-        return !summary.search_type.empty() && summary.matches_found >= 0 && summary.time_took >= 0.0;
+        return !summary.search_type.empty() && summary.time_took >= 0.0;
     }
 
     /**
@@ -12,6 +12,9 @@ using namespace FiltersMap;
 using namespace StandardMCSSearch;
 using namespace PositionalMCSSearch;
 using namespace FinalSummary;
+using namespace StreamingMCSSearch;
+using namespace ResultFile;
+using namespace CorpusIngestion;
 
 int main() {
     int choice;
@@ -51,6 +54,15 @@ int main() {
         case 9:
             handle_operation(create_final_summary, choice);
             break;
+        case 10:
+            handle_operation(run_streaming_mcs_search, choice);
+            break;
+        case 11:
+            handle_operation(run_results_conversion, choice);
+            break;
+        case 12:
+            handle_operation(run_corpus_ingestion, choice);
+            break;
         case 0:
             cout << "Exiting program. Goodbye!\n";
             return 0;
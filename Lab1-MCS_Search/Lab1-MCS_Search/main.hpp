@@ -14,5 +14,8 @@
 #include "standard_mcs_search.hpp"
 #include "positional_mcs_search.hpp"
 #include "final_summary.hpp"
+#include "streaming_mcs_search.hpp"
+#include "result_file.hpp"
+#include "corpus_ingestion.hpp"
 
 #endif
\ No newline at end of file
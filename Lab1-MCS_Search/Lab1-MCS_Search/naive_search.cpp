@@ -3,6 +3,7 @@
 using namespace std;
 using namespace Config;
 using namespace Utils;
+using namespace ResultFile;
 using namespace chrono;
 
 namespace NaiveSearch {
@@ -23,7 +24,7 @@ namespace NaiveSearch {
      *         false otherwise.
      *
      */
-    bool check_matches(const string& text, size_t text_index, const string& word) {
+    bool check_matches(string_view text, size_t text_index, const string& word) {
         if (text_index > text.size() || text_index + word.length() > text.size()) {
             return false;
         }
@@ -44,7 +45,7 @@ namespace NaiveSearch {
      * @param word The word to search for.
      * @return vector<int> List of 1-based starting positions.
      */
-    static vector<size_t> find_word_positions(const string& text, const string& word) {
+    static vector<size_t> find_word_positions(string_view text, const string& word) {
         vector<size_t> positions;
         size_t text_len = text.length();
         size_t word_len = word.length();
@@ -67,47 +68,42 @@ namespace NaiveSearch {
      */
     int perform_naive_search() {
         cout << "[NaiveSearch] Starting naive search...\n";
-        int count_total_finds = 0;
+        size_t count_total_finds = 0;
 
-        // Load the text to search from file
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        // Load the text and search words from file, both at once
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME);
+        string_view text;
+        if (loader.wait_text(text) != 0) {
             cerr << "[NaiveSearch] Failed to load input text.\n";
             return -1;
         }
 
-        // Load search words from file
-        vector<string> search_words = read_lines_from_file(SEARCH_WORDS_FILENAME);
-        if (search_words.empty()) {
-            cerr << "[NaiveSearch] Failed to load search words.\n";
-            return -1;
-        }
-
-        set<WordMatch> unique_matches;
+        vector<string> search_words;
+        vector<WordMatch> results;
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
         auto start = steady_clock::now();
 
-        // Search each unique word only once
-        size_t total_words = search_words.size();
-        size_t processed = 0;
-
-        for (const auto& word : search_words) {
-            vector<size_t> positions = find_word_positions(text, word);
-            for (size_t pos : positions) {
-                if (insert_or_update_match(unique_matches, word, pos))
-                    count_total_finds++;
-            }
-            print_progress(static_cast<int>(++processed), static_cast<int>(total_words));
+        // Search the words in parallel, each worker keeps its hits to itself
+        cout << "[NaiveSearch] Searching words on " << scheduler.threads_count() << " threads...\n";
+        int words_status = loader.run_word_batches(scheduler, search_words, [&](unsigned worker, size_t word_index, const string& word) {
+            for (size_t pos : find_word_positions(text, word))
+                thread_hits[worker].push_back({ word_index, pos });
+        });
+        if (words_status != 0) {
+            cerr << "[NaiveSearch] Failed to load search words.\n";
+            return -1;
         }
+        count_total_finds = merge_word_hits(thread_hits, search_words, results);
 
         auto end = steady_clock::now();
         duration<double> elapsed_seconds = end - start;
         double seconds = elapsed_seconds.count();
         Summary summary = { "Naive Search", count_total_finds, seconds };
+        scheduler.print_stats("[NaiveSearch]");
 
-        // Prepare output lines
-        vector<WordMatch> results_vector(unique_matches.begin(), unique_matches.end());
-        vector<string> lines = convert_matches_to_lines(results_vector);
-        int status = save_to_file(lines, NAIVE_SEARCH_OUTPUT_FILENAME, true);
+        // Save results to file
+        int status = save_results(results, search_words, "Naive Search", without_line_break(text).size(), NAIVE_SEARCH_OUTPUT_FILENAME);
         if (save_to_file(summary.to_lines(), NAIVE_SEARCH_SUMMARY_FILENAME, true) != 0)
             cout << "[NaiveSearch] Summary failed saving.\n";
         else cout << "[NaiveSearch] Summary file has saved to " << NAIVE_SEARCH_SUMMARY_FILENAME << "\n";
@@ -8,8 +8,11 @@
 
 #include "config.hpp"
 #include "utils.hpp"
+#include "result_file.hpp"
 #include "WordMatch.hpp"
 #include "Summary.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "SearchInputLoader.hpp"
 
 namespace NaiveSearch {
 
@@ -30,7 +33,7 @@ namespace NaiveSearch {
      *
      * @note Assumes that `text_index + word.length()` does not exceed `text.size()`.
      */
-    bool check_matches(const string& text, size_t text_index, const string& word);
+    bool check_matches(std::string_view text, size_t text_index, const string& word);
 
     /**
      * @brief Performs naive search for all given words and writes results to file.
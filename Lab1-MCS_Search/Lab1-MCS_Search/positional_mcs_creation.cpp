@@ -77,6 +77,7 @@ namespace PositionalMCS {
             cout << "[PositionalMCS] Reduction of combinations phase has started.\n";
             int total_combinations = static_cast<int>(all_valid_combinations.size());
             vector<string> reduced_combinations;
+            Telemetry::ProgressCounter reduction_progress("Reduction", total_combinations);
 
             for (int combination_index = total_combinations - 1; combination_index >= 0; --combination_index) {
                 bool should_remove = false;
@@ -91,8 +92,9 @@ namespace PositionalMCS {
                 if (!should_remove)
                     reduced_combinations.push_back(all_valid_combinations[combination_index]);
 
-                print_progress(processed++, total_combinations);
+                reduction_progress.set(++processed);
             }
+            reduction_progress.finish();
 
             all_valid_combinations = reduced_combinations;
 
@@ -103,6 +105,7 @@ namespace PositionalMCS {
                 int total_reduced = static_cast<int>(reduced_combinations.size());
                 vector<bool> mcs_filter_protected(mcs_i_plus_1.size(), true);
                 processed = 0;
+                Telemetry::ProgressCounter protection_progress("Protected filters", total_reduced);
 
                 for (const string& combination : reduced_combinations) {
                     vector<bool> mcs_filter_match(mcs_i_plus_1.size(), false);
@@ -124,8 +127,9 @@ namespace PositionalMCS {
                         }
                     }
 
-                    print_progress(++processed, total_reduced);
+                    protection_progress.set(++processed);
                 }
+                protection_progress.finish();
 
                 // == Phase 2.3: Randomly remove an unprotected filter from mcs[i]
                 cout << "\n[PositionalMCS] Removing one unprotected filter...\n";
@@ -2,6 +2,7 @@
 
 using namespace std;
 using namespace Utils;
+using namespace ResultFile;
 using namespace Config;
 using namespace FiltersMap;
 using namespace StandardMCSSearch;
@@ -9,6 +10,67 @@ using namespace chrono;
 
 namespace PositionalMCSSearch {
 
+    /**
+     * @brief Loads positional_mcs_output_0..n into a flat list of bit mask filters.
+     *
+     * Each filter of layer i becomes one entry with offset i, so the search loop
+     * runs over a single contiguous array instead of nested vectors of filter strings.
+     * A filter whose last '1' falls outside the search word at its offset, or that keeps
+     * no character, is skipped and counted in `skipped_count`.
+     *
+     * @param positional_filters The filters list to fill.
+     * @return int Returns 0 on success, or -1 if no layer could be loaded.
+     */
+    int load_positional_filters(PositionalFilters& positional_filters) {
+        positional_filters.filters.clear();
+        positional_filters.layers_count = 0;
+        positional_filters.skipped_count = 0;
+
+        while (true) {
+            string filename = POSITIONAL_MCS_OUTPUT_FILENAME + "_" + to_string(positional_filters.layers_count);
+            MappedLines layer;
+            if (map_lines_from_file(filename, layer, false) != 0 || layer.lines.empty()) break;
+
+            for (string_view filter : layer.lines) {
+                // Only the kept characters are read, so trailing '0's may run past the window
+                size_t last_one_index = filter.find_last_of('1');
+                if (last_one_index == string_view::npos || last_one_index >= 64 ||
+                    positional_filters.layers_count + last_one_index >= SEARCH_WORD_SIZE) {
+                    positional_filters.skipped_count++;
+                    continue;
+                }
+
+                uint64_t mask = 0;
+                for (size_t i = 0; i <= last_one_index; ++i)
+                    if (filter[i] == '1')
+                        mask |= (1ULL << i);
+
+                positional_filters.filters.push_back({ mask, static_cast<uint16_t>(positional_filters.layers_count) });
+            }
+            positional_filters.layers_count++;
+        }
+
+        return positional_filters.layers_count > 0 ? 0 : -1;
+    }
+
+    /**
+     * @brief Builds the filters map key of a word for a positional filter into a reusable buffer.
+     *
+     * Produces the same key as `apply_filter_to_word(word, filter, offset)` without allocating.
+     *
+     * @param word The search word.
+     * @param filter The positional filter to apply.
+     * @param key Buffer of size word.size(), filled with '_' except for the kept characters.
+     */
+    void apply_positional_filter_to_word(const string& word, const PositionalFilter& filter, string& key) {
+        key.assign(word.size(), '_');
+
+        uint64_t mask = filter.mask;
+        for (size_t i = 0; mask != 0; ++i, mask >>= 1)
+            if (mask & 1)
+                key[i] = word[filter.offset + i];
+    }
+
     /**
      * @brief Executes a positional MCS (Masked Common Substring) search on a given text using precomputed filters.
      *
@@ -27,35 +89,24 @@ namespace PositionalMCSSearch {
     int run_positional_mcs_search() {
         cout << "[PositionalMCSSearch] Starting usual MCS search...\n";
 
-        // Load Text
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
-            cerr << "[PositionalMCSSearch] Failed to load text - its empty or doesn`t exist.\n";
-            return -1;
-        }
+        // Load text and search words in the background while the filters are loaded
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME);
 
-        // Load MCS filters
-        vector<vector<string>> all_mcs;
-        int i = 0;
-        while (i >= 0) {
-            string filename = POSITIONAL_MCS_OUTPUT_FILENAME + "_" + to_string(i);
-            vector<string> curr_mcs_filters = read_lines_from_file(filename, false);
-            if (curr_mcs_filters.empty()) {
-                if (i == 0) {
-                    cerr << "[PositionalMCSSearch] Failed to load MCS filters - its empty or doens`t exist.\n";
-                    return -1;
-                }
-                break;
-            }
-            all_mcs.push_back(curr_mcs_filters);
-            i++;
+        // Load MCS filters into a flat list
+        PositionalFilters positional_filters;
+        if (load_positional_filters(positional_filters) != 0) {
+            cerr << "[PositionalMCSSearch] Failed to load MCS filters - its empty or doens`t exist.\n";
+            return -1;
         }
         cout << "[PositionalMCSSearch] Successfully loaded all MCS files.\n";
+        cout << "[PositionalMCSSearch] Loaded " << positional_filters.layers_count << " layers with "
+             << positional_filters.filters.size() << " filters (lookups per query).\n";
+        if (positional_filters.skipped_count > 0)
+            cout << "[PositionalMCSSearch] Skipped " << positional_filters.skipped_count << " filters that do not fit the search word at their offset.\n";
 
-        // Load search words
-        vector<string> search_words = read_lines_from_file(SEARCH_WORDS_FILENAME);
-        if (search_words.empty()) {
-            cerr << "[PositionalMCSSearch] Failed to load search words.\n";
+        string_view text;
+        if (loader.wait_text(text) != 0) {
+            cerr << "[PositionalMCSSearch] Failed to load text - its empty or doesn`t exist.\n";
             return -1;
         }
 
@@ -66,43 +117,41 @@ namespace PositionalMCSSearch {
         }
 
         // --- Prepare container to collect results ---
-        set<WordMatch> results;
-        size_t total_words = search_words.size();
-        size_t total_mcs = all_mcs.size();
-        int count_total_finds = 0;
+        vector<string> search_words;
+        vector<WordMatch> results;
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
+        vector<string> thread_keys(scheduler.threads_count());
 
         auto start = steady_clock::now();
 
-        // --- Iterate over each search word ---
-        cout << "[PositionalMCSSearch] Start iterating over search words..\n";
-        for (size_t word_index = 0; word_index < total_words; ++word_index) {
-            const string& word = search_words[word_index];
-            const size_t search_word_length = word.length();
-
-            // --- Iterate over each all_mcs[i]
-            for (size_t mcs_filter_index = 0; mcs_filter_index < total_mcs; mcs_filter_index++) { // mcs_filter_index is also the sliding window index
+        // --- Iterate over each search word, in parallel ---
+        cout << "[PositionalMCSSearch] Start iterating over search words on " << scheduler.threads_count() << " threads..\n";
+        int words_status = loader.run_word_batches(scheduler, search_words, [&](unsigned worker, size_t word_index, const string& word) {
+            string& key = thread_keys[worker];
 
-                // --- Try all filters on this word ---
-                for (const string& filter : all_mcs[mcs_filter_index]) {
-                    string filtered_word = apply_filter_to_word(word, filter, mcs_filter_index);
+            // --- Apply every positional filter to this word ---
+            for (const PositionalFilter& filter : positional_filters.filters) {
+                apply_positional_filter_to_word(word, filter, key);
 
-                    // --- Check if this masked word appears in the filters map ---
-                    count_total_finds += search_and_insert_matches(filtered_word, word, text, mcs_filter_index, results);
-                }
+                // --- Check if this masked word appears in the filters map ---
+                search_and_collect_matches(key, word, word_index, text, filter.offset, thread_hits[worker]);
             }
-            print_progress(static_cast<int>(word_index), static_cast<int>(total_words));
+        });
+        if (words_status != 0) {
+            cerr << "[PositionalMCSSearch] Failed to load search words.\n";
+            return -1;
         }
+        size_t count_total_finds = merge_word_hits(thread_hits, search_words, results);
 
         auto end = steady_clock::now();
         duration<double> elapsed_seconds = end - start;
         double seconds = elapsed_seconds.count();
         Summary summary = { "Positional Search", count_total_finds, seconds };
-
-        vector<WordMatch> results_vector(results.begin(), results.end());
-        vector<string> output_lines = convert_matches_to_lines(results_vector);
+        scheduler.print_stats("[PositionalMCSSearch]");
 
         // Save results to file
-        int status = save_to_file(output_lines, POSITIONAL_MCS_SEARCH_OUTPUT_FILENAME, true);
+        int status = save_results(results, search_words, "Positional MCS Search", without_line_break(text).size(), POSITIONAL_MCS_SEARCH_OUTPUT_FILENAME);
         if (save_to_file(summary.to_lines(), POSITIONAL_MCS_SEARCH_SUMMARY_FILENAME, true) != 0)
             cout << "[PositionalMCSSearch] Summary failed saving.\n";
         else cout << "[PositionalMCSSearch] Summary file has saved to " << POSITIONAL_MCS_SEARCH_SUMMARY_FILENAME << "\n";
@@ -3,15 +3,64 @@
 
 
 #include <chrono>
+#include <cstdint>
 #include "WordMatch.hpp"
 #include "Summary.hpp"
 #include "utils.hpp"
+#include "dataset_cache.hpp"
+#include "result_file.hpp"
 #include "config.hpp"
 #include "create_filters_map.hpp"
 #include "standard_mcs_search.hpp"
 
 namespace PositionalMCSSearch {
 
+    /**
+     * @brief A single positional filter - one filters map lookup per search word.
+     *
+     * `mask` holds the '1' bits of the filter (bit i set means the filter keeps position i),
+     * and `offset` is the sliding window index of the MCS layer the filter came from.
+     * The filter's own id is not kept: the filters map is keyed by the masked word alone,
+     * so no lookup or match depends on which filter produced the key.
+     */
+    struct PositionalFilter {
+        uint64_t mask;
+        uint16_t offset;
+    };
+
+    /**
+     * @brief The filters of all positional MCS layers, kept in one flat, contiguous list.
+     */
+    struct PositionalFilters {
+        vector<PositionalFilter> filters;
+        size_t layers_count = 0;
+        size_t skipped_count = 0; // Filters left out because they overrun the search word
+    };
+
+    /**
+     * @brief Loads positional_mcs_output_0..n into a flat list of bit mask filters.
+     *
+     * Each filter of layer i becomes one entry with offset i, so the search loop
+     * runs over a single contiguous array instead of nested vectors of filter strings.
+     * A filter whose last '1' falls outside the search word at its offset, or that keeps
+     * no character, is skipped and counted in `skipped_count`.
+     *
+     * @param positional_filters The filters list to fill.
+     * @return int Returns 0 on success, or -1 if no layer could be loaded.
+     */
+    int load_positional_filters(PositionalFilters& positional_filters);
+
+    /**
+     * @brief Builds the filters map key of a word for a positional filter into a reusable buffer.
+     *
+     * Produces the same key as `apply_filter_to_word(word, filter, offset)` without allocating.
+     *
+     * @param word The search word.
+     * @param filter The positional filter to apply.
+     * @param key Buffer of size word.size(), filled with '_' except for the kept characters.
+     */
+    void apply_positional_filter_to_word(const string& word, const PositionalFilter& filter, string& key);
+
     /**
 	 * @brief Executes a positional MCS (Masked Common Substring) search on a given text using precomputed filters.
 	 *
@@ -6,32 +6,98 @@ using namespace Utils;
 
 namespace RandomText {
 
+    static_assert(TEXT_GENERATION_CHUNK_SIZE % CHARS_PER_DRAW == 0, "TEXT_GENERATION_CHUNK_SIZE must be a multiple of 4");
+
+    /**
+     * @brief SplitMix64 output function - maps a counter value to 64 well-mixed random bits.
+     *
+     * @param counter The counter to mix.
+     * @return uint64_t The random bits of this counter.
+     */
+    uint64_t split_mix64(uint64_t counter) {
+        uint64_t z = counter;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Writes the random characters of text positions [first, first + count) to `out`.
+     *
+     * Every group of CHARS_PER_DRAW positions takes its characters from one SplitMix64 draw of
+     * its own index, so any range can be generated independently and the text depends only on
+     * the seed. `first` must be a multiple of CHARS_PER_DRAW.
+     *
+     * @param out The buffer to write the characters to.
+     * @param first The text position of out[0].
+     * @param count Number of characters to write.
+     * @param seed The seed of the text.
+     */
+    void fill_random_chars(char* out, uint64_t first, uint64_t count, uint64_t seed) {
+        const uint32_t letters_count = 'z' - Y_LETTER + 1;
+        uint64_t written = 0;
+
+        for (uint64_t draw = first / CHARS_PER_DRAW; written < count; ++draw) {
+            uint64_t bits = split_mix64(seed + (draw + 1) * 0x9E3779B97F4A7C15ULL);
+
+            // 16 bits per character, scaled into the letter range
+            for (uint64_t lane = 0; lane < CHARS_PER_DRAW && written < count; ++lane, bits >>= 16)
+                out[written++] = static_cast<char>(Y_LETTER + (((bits & 0xFFFF) * letters_count) >> 16));
+        }
+    }
+
     /**
      * @brief Generates random text of size TEXT_SIZE using chars from Y_LETTER to 'z',
      * and saves it to RANDOM_GENERATED_TEXT_FILENAME.txt.
      *
+     * The text is generated in chunks of TEXT_GENERATION_CHUNK_SIZE characters on all worker
+     * threads, straight into a memory-mapped output file. It is the same for a given
+     * RANDOM_TEXT_SEED no matter how many threads generate it. The letters are saved as the
+     * alphabet of the text.
+     *
      * @return int Returns 0 on success, -1 if saving the file failed.
      */
     int generate_text_and_save() {
         // === Random text generation setup ===
         cout << "[RandomText] Generating random text of size " << TEXT_SIZE << "...\n";
 
-        static random_device rd;
-        static mt19937 gen(rd());
-        uniform_int_distribution<> dist(Y_LETTER, 'z');
+        uint64_t seed = RANDOM_TEXT_SEED;
+        if (seed == 0) {
+            random_device rd;
+            seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+        }
+        cout << "[RandomText] Seed: " << seed << "\n";
 
-        string text;
-        text.reserve(TEXT_SIZE);
+        // === Map the output file, the text followed by a newline like save_to_file writes it ===
+        const size_t text_size = static_cast<size_t>(TEXT_SIZE);
+        MappedOutputFile output;
+        int status = create_mapped_output(output, RANDOM_GENERATED_TEXT_FILENAME, text_size + 1);
+        if (status != 0) return status;
 
-        for (int i = 0; i < TEXT_SIZE; ++i) {
-            text += static_cast<char>(dist(gen));
-            print_progress(i, TEXT_SIZE);
-        }
+        // === Generate the chunks in parallel ===
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        size_t chunks_count = (text_size + TEXT_GENERATION_CHUNK_SIZE - 1) / TEXT_GENERATION_CHUNK_SIZE;
+        char* text = output.data();
+        Telemetry::ProgressCounter progress("Text", text_size);
+
+        scheduler.run(chunks_count, [&](unsigned, size_t chunk) {
+            size_t first = chunk * TEXT_GENERATION_CHUNK_SIZE;
+            size_t count = min(TEXT_GENERATION_CHUNK_SIZE, text_size - first);
+            fill_random_chars(text + first, first, count, seed);
+            progress.add(count);
+        });
+        text[text_size] = '\n';
+        progress.finish();
 
         // === Save to file ===
-        int status = save_to_file({ text }, RANDOM_GENERATED_TEXT_FILENAME);
-        if (status == 0) cout << "[RandomText] Text generation complete.\n";
-        return status;
+        if (output.close() != 0) {
+            cerr << "[RandomText] Failed to write file: " << RANDOM_GENERATED_TEXT_FILENAME << ".txt\n";
+            return -1;
+        }
+        cout << "[RandomText] Text generation complete, saved to " << RANDOM_GENERATED_TEXT_FILENAME << ".txt\n";
+
+        // The letters replace the alphabet of an ingested corpus
+        return Alphabet::letters(Y_LETTER, 'z').save(ALPHABET_FILENAME);
     }
 
-}
\ No newline at end of file
+}
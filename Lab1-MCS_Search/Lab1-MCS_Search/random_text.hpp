@@ -4,19 +4,52 @@
 #include <string>
 #include <random>
 #include <vector>
+#include <cstdint>
+#include <algorithm>
 
 #include "config.hpp"
 #include "utils.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "Alphabet.hpp"
 
 namespace RandomText {
 
+    const uint64_t CHARS_PER_DRAW = 4; // Characters taken from every 64-bit random draw
+
+    /**
+     * @brief SplitMix64 output function - maps a counter value to 64 well-mixed random bits.
+     *
+     * @param counter The counter to mix.
+     * @return uint64_t The random bits of this counter.
+     */
+    uint64_t split_mix64(uint64_t counter);
+
+    /**
+     * @brief Writes the random characters of text positions [first, first + count) to `out`.
+     *
+     * Every group of CHARS_PER_DRAW positions takes its characters from one SplitMix64 draw of
+     * its own index, so any range can be generated independently and the text depends only on
+     * the seed. `first` must be a multiple of CHARS_PER_DRAW.
+     *
+     * @param out The buffer to write the characters to.
+     * @param first The text position of out[0].
+     * @param count Number of characters to write.
+     * @param seed The seed of the text.
+     */
+    void fill_random_chars(char* out, uint64_t first, uint64_t count, uint64_t seed);
+
     /**
      * @brief Generates random text of size TEXT_SIZE using chars from Y_LETTER to 'z',
      * and saves it to RANDOM_GENERATED_TEXT_FILENAME.txt.
      *
+     * The text is generated in chunks of TEXT_GENERATION_CHUNK_SIZE characters on all worker
+     * threads, straight into a memory-mapped output file. It is the same for a given
+     * RANDOM_TEXT_SEED no matter how many threads generate it. The letters are saved as the
+     * alphabet of the text.
+     *
      * @return int Returns 0 on success, -1 if saving the file failed.
      */
     int generate_text_and_save();
 }
 
-#endif
\ No newline at end of file
+#endif
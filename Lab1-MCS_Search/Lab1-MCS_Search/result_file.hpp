@@ -0,0 +1,93 @@
+#ifndef RESULT_FILE_HPP
+#define RESULT_FILE_HPP
+
+#include "utils.hpp"
+#include "config.hpp"
+#include "WordMatch.hpp"
+#include <cstdint>
+
+namespace ResultFile {
+
+    /**
+     * @brief Fixed-size header at the start of a binary results file.
+     *
+     * The header is followed by four sections, each addressed by its byte offset:
+     * the word offsets (words_count + 1 uint64 offsets into the word characters), the
+     * position offsets (words_count + 1 uint64 offsets into the positions), the sorted
+     * positions of every word (position_size bytes each), and the characters of all
+     * words back to back.
+     */
+    struct ResultFileHeader {
+        char magic[8];                      // RESULT_FILE_MAGIC
+        uint32_t version;                   // RESULT_FILE_VERSION
+        uint32_t byte_order;                // RESULT_FILE_BYTE_ORDER as written by the creating machine
+        char engine[28];                    // Name of the search that produced the results
+        uint32_t position_size;             // sizeof(Config::TextPosition) of the creating program - 4 or 8
+        uint64_t text_size;                 // Length of the searched text, without its trailing line break
+        uint32_t search_word_size;          // Config::SEARCH_WORD_SIZE
+        uint32_t minimal_matches;           // Config::MINIMAL_MATCHES
+        uint32_t filter_matches;            // Config::FILTER_NUMBER_OF_MATCHES
+        uint32_t y_letter;                  // Config::Y_LETTER
+        uint64_t words_count;
+        uint64_t positions_count;
+        uint64_t word_offsets_offset;
+        uint64_t position_offsets_offset;
+        uint64_t positions_offset;
+        uint64_t word_chars_offset;
+        uint64_t word_chars_size;
+    };
+
+    const char RESULT_FILE_MAGIC[8] = { 'M', 'C', 'S', 'R', 'E', 'S', '\0', '\0' };
+    const uint32_t RESULT_FILE_VERSION = 3;
+    const uint32_t RESULT_FILE_BYTE_ORDER = 0x01020304;
+    const std::string RESULT_FILE_EXTENSION = ".bin";
+
+    /**
+     * @brief Saves search results in the binary results format, and also as text when Config::SAVE_RESULTS_AS_TEXT is set.
+     *
+     * @param matches The results, sorted by word.
+     * @param search_words The search words the matches' word ids refer to.
+     * @param engine Name of the search that produced the results.
+     * @param text_size Length of the searched text, without its trailing line break.
+     * @param filename The target filename, without extension.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_results(const vector<WordMatch>& matches, const vector<std::string>& search_words, const std::string& engine, uint64_t text_size, const std::string& filename);
+
+    /**
+     * @brief Maps a binary results file and checks its header and section offsets.
+     *
+     * @param filename The results filename, without extension (reads .bin).
+     * @param file The mapping to open; the sections point into it.
+     * @param header Set to the header of the file, with a null-terminated engine name.
+     * @return int 0 on success, -1 if the file is missing, truncated or corrupted.
+     */
+    int map_results(const std::string& filename, MappedFile& file, ResultFileHeader& header);
+
+    /**
+     * @brief Returns the position at `index` of the positions section of a mapped results file.
+     *
+     * @param file The mapped results file.
+     * @param header The header of the file, as returned by map_results().
+     * @param index Index of the position, below header.positions_count.
+     * @return uint64_t The text position, whatever the position size of the file.
+     */
+    uint64_t read_position(const MappedFile& file, const ResultFileHeader& header, uint64_t index);
+
+    /**
+     * @brief Converts a binary results file into the "Word: / Positions:" text format.
+     *
+     * @param filename The results filename, without extension (reads .bin, writes .txt).
+     * @return int 0 on success, -1 on failure.
+     */
+    int convert_results_to_text(const std::string& filename);
+
+    /**
+     * @brief Converts every binary search results file listed in Config::SEARCH_OUTPUT_FILENAMES that exists.
+     *
+     * @return int 0 on success, -1 if no file was found or a conversion failed.
+     */
+    int run_results_conversion();
+}
+
+#endif
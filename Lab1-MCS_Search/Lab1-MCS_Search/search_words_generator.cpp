@@ -21,11 +21,12 @@ namespace SearchWordsGenerator {
     int generate_search_words() {
         cout << "[SearchWords] Generating " << NUMBER_OF_SEARCH_WORDS << " Search Words...\n";
         // Step 1: Load full text content
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        shared_ptr<const MappedText> cached_text;
+        if (DatasetCache::get_text(RANDOM_GENERATED_TEXT_FILENAME, cached_text) != 0) {
             cerr << "[SearchWords] Failed to load text content.\n";
             return -1;
         }
+        string_view text = cached_text->text;
 
         // Step 2: Validate text is long enough
         size_t requiredLength = SEARCH_WORD_SIZE * NUMBER_OF_SEARCH_WORDS;
@@ -37,16 +38,16 @@ namespace SearchWordsGenerator {
         // Step 3: Generate vector of search words
         vector<string> searchWords;
         size_t i = 0;
+        Telemetry::ProgressCounter progress("Search words", NUMBER_OF_SEARCH_WORDS);
 
         while (searchWords.size() < NUMBER_OF_SEARCH_WORDS && i + SEARCH_WORD_SIZE <= text.length()) {
-            string word = text.substr(i, SEARCH_WORD_SIZE);
+            string word(text.substr(i, SEARCH_WORD_SIZE));
             searchWords.push_back(word);
             i += SEARCH_WORD_SIZE;  // Move to next non-overlapping segment
 
-            print_progress(static_cast<int>(searchWords.size()), static_cast<int>(NUMBER_OF_SEARCH_WORDS));
+            progress.set(searchWords.size());
         }
-        print_progress(static_cast<int>(NUMBER_OF_SEARCH_WORDS), static_cast<int>(NUMBER_OF_SEARCH_WORDS));
-        cout << '\n';
+        progress.finish();
 
         // Step 4: Save the vector to a file
         int status = save_to_file(searchWords, SEARCH_WORDS_FILENAME);
@@ -5,6 +5,7 @@
 #include <vector>
 #include "config.hpp"
 #include "utils.hpp"
+#include "dataset_cache.hpp"
 
 namespace SearchWordsGenerator {
 
@@ -2,6 +2,7 @@
 
 using namespace std;
 using namespace Utils;
+using namespace ResultFile;
 using namespace Config;
 using namespace FiltersMap;
 using namespace chrono;
@@ -10,42 +11,37 @@ using namespace NaiveSearch;
 namespace StandardMCSSearch {
 
     /**
-     * @brief Searches for matches of a filtered word in a given text and returns the total count of matches found.
+     * @brief Searches for matches of a filtered word in a given text and collects the matches found.
      *
      * This method searches for occurrences of `filtered_word` in the global `filters_map` and compares the characters
      * in surrounding positions of the `text` to count the matches. If the number of matches exceeds the defined threshold,
-     * it updates the `results` vector with the matching positions and increments the total count of finds.
+     * the matching position is appended to `hits`.
      *
      * @param filtered_word The word after applying the filter, which is to be searched.
      * @param word The original word being checked for matches.
+     * @param word_index Index of the word in the search list.
      * @param text The text to search for matches in.
      * @param sliding_window_index The index used for adjusting word positions in the text.
-     * @param results A set to store the matches.
-     * @return The total count of finds (matches found).
+     * @param hits The buffer of the calling worker to append the matches to.
      */
-    int search_and_insert_matches(const string& filtered_word, const string& word, const string& text,
-        size_t sliding_window_index, set<WordMatch>& results) {
-        int count_total_finds = 0;
-
+    void search_and_collect_matches(const string& filtered_word, const string& word, size_t word_index, string_view text,
+        size_t sliding_window_index, vector<WordHit>& hits) {
         // Search the filtered_word in the filters_map
         auto it = filters_map.find(filtered_word);
         if (it != filters_map.end()) {
             // Iterate over the positions where the filtered word was found
-            for (size_t pos : it->second.positions) {
+            for (TextPosition pos : it->second) {
                 size_t position_text = pos - sliding_window_index - 1;
 
                 // Ensure we're not overflowing the text by checking boundaries, skip position if does
                 if (position_text + word.size() >= text.size())
                     continue;
 
-                // If matches exceed the threshold, insert or update the match
-                if (check_matches(text, position_text, word)) {
-                    if (insert_or_update_match(results, word, position_text + 1))
-                        count_total_finds++;
-                }
+                // If matches exceed the threshold, keep the match (1-based position)
+                if (check_matches(text, position_text, word))
+                    hits.push_back({ word_index, position_text + 1 });
             }
         }
-        return count_total_finds;
     }
 
 
@@ -61,29 +57,22 @@ namespace StandardMCSSearch {
      */
     int run_standard_mcs_search() {
         cout << "[StandardMCSSearch] Starting usual MCS search...\n";
-        int count_total_finds = 0;
+        size_t count_total_finds = 0;
 
-        // Load Text
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        // Load text, MCS filters and search words, all at once
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME, STANDARD_MCS_OUTPUT_FILENAME);
+        string_view text;
+        if (loader.wait_text(text) != 0) {
             cerr << "[StandardMCSSearch] Failed to load text - its empty or doesn`t exist.\n";
             return -1;
         }
 
-        // Load MCS filters
-        vector<string> mcs_filters = read_lines_from_file(STANDARD_MCS_OUTPUT_FILENAME);
-        if (mcs_filters.empty()) {
+        const vector<string>* mcs_filters;
+        if (loader.wait_filters(mcs_filters) != 0) {
             cerr << "[StandardMCSSearch] Failed to load MCS filters - its empty or doens`t exist.\n";
             return -1;
         }
 
-        // Load search words
-        vector<string> search_words = read_lines_from_file(SEARCH_WORDS_FILENAME);
-        if (search_words.empty()) {
-            cerr << "[StandardMCSSearch] Failed to load search words.\n";
-            return -1;
-        }
-
         // Verify filters map exist
         if (filters_map.empty()) {
             cerr << "[StandardMCSSearch] Failed to load filters map - its empty.\n";
@@ -91,19 +80,20 @@ namespace StandardMCSSearch {
         }
 
         // --- Prepare container to collect results ---
-        set<WordMatch> results;
-        size_t total_words = search_words.size();
+        vector<string> search_words;
+        vector<WordMatch> results;
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
 
         auto start = steady_clock::now();
 
-        // --- Iterate over each search word ---
-        cout << "[StandardMCSSearch] Start iterating over search words..\n";
-        for (size_t word_index = 0; word_index < total_words; ++word_index) {
-            const string& word = search_words[word_index];
+        // --- Iterate over each search word, in parallel ---
+        cout << "[StandardMCSSearch] Start iterating over search words on " << scheduler.threads_count() << " threads..\n";
+        int words_status = loader.run_word_batches(scheduler, search_words, [&](unsigned worker, size_t word_index, const string& word) {
             const size_t search_word_length = word.length();
 
             // --- Try all filters on this word ---
-            for (const string& filter : mcs_filters) {
+            for (const string& filter : *mcs_filters) {
                 size_t filter_length = filter.length();
 
                 // --- Slide the filter over the word ---
@@ -111,22 +101,24 @@ namespace StandardMCSSearch {
                     string filtered_word = apply_filter_to_word(word, filter, sliding_window_index);
 
                     // --- Check if this masked word appears in the filters map ---
-                    count_total_finds += search_and_insert_matches(filtered_word, word, text, sliding_window_index, results);
+                    search_and_collect_matches(filtered_word, word, word_index, text, sliding_window_index, thread_hits[worker]);
                 }
             }
-            print_progress(static_cast<int>(word_index), static_cast<int>(total_words));
+        });
+        if (words_status != 0) {
+            cerr << "[StandardMCSSearch] Failed to load search words.\n";
+            return -1;
         }
+        count_total_finds = merge_word_hits(thread_hits, search_words, results);
 
         auto end = steady_clock::now();
         duration<double> elapsed_seconds = end - start;
         double seconds = elapsed_seconds.count();
         Summary summary = { "Positional Search", count_total_finds, seconds };
-
-        vector<WordMatch> results_vector(results.begin(), results.end());
-        vector<string> output_lines = convert_matches_to_lines(results_vector);
+        scheduler.print_stats("[StandardMCSSearch]");
 
         // Save results to file
-        int status = save_to_file(output_lines, STANDARD_MCS_SEARCH_OUTPUT_FILENAME, true);
+        int status = save_results(results, search_words, "Standard MCS Search", without_line_break(text).size(), STANDARD_MCS_SEARCH_OUTPUT_FILENAME);
         if (save_to_file(summary.to_lines(), STANDARD_MCS_SEARCH_SUMMARY_FILENAME, true) != 0)
             cout << "[StandardMCSSearch] Summary failed saving.\n";
         else cout << "[StandardMCSSearch] Summary file has saved to " << STANDARD_MCS_SEARCH_SUMMARY_FILENAME << "\n";
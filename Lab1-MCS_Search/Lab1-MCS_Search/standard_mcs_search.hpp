@@ -12,28 +12,31 @@
 #include "Summary.hpp"
 #include "WordMatch.hpp"
 #include "utils.hpp"
+#include "result_file.hpp"
 #include "config.hpp"
 #include "create_filters_map.hpp"
 #include "naive_search.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "SearchInputLoader.hpp"
 
 namespace StandardMCSSearch {
 
 	/**
-	 * @brief Searches for matches of a filtered word in a given text and returns the total count of matches found.
+	 * @brief Searches for matches of a filtered word in a given text and collects the matches found.
 	 *
 	 * This method searches for occurrences of `filtered_word` in the global `filters_map` and compares the characters
 	 * in surrounding positions of the `text` to count the matches. If the number of matches exceeds the defined threshold,
-	 * it updates the `results` vector with the matching positions and increments the total count of finds.
+	 * the matching position is appended to `hits`.
 	 *
 	 * @param filtered_word The word after applying the filter, which is to be searched.
 	 * @param word The original word being checked for matches.
+	 * @param word_index Index of the word in the search list.
 	 * @param text The text to search for matches in.
 	 * @param sliding_window_index The index used for adjusting word positions in the text.
-	 * @param results A set to store the matches.
-	 * @return The total count of finds (matches found).
+	 * @param hits The buffer of the calling worker to append the matches to.
 	 */
-	int search_and_insert_matches(const string& filtered_word, const string& word, const string& text,
-		size_t sliding_window_index, set<WordMatch>& results);
+	void search_and_collect_matches(const string& filtered_word, const string& word, size_t word_index, std::string_view text,
+		size_t sliding_window_index, vector<WordHit>& hits);
 
 	/**
 	 * @brief Executes a standard MCS search using filters and a filters map.
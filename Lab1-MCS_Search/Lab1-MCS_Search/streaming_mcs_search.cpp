@@ -0,0 +1,180 @@
+#include "streaming_mcs_search.hpp"
+
+using namespace std;
+using namespace Utils;
+using namespace ResultFile;
+using namespace Config;
+using namespace NaiveSearch;
+using namespace chrono;
+
+namespace StreamingMCSSearch {
+
+    /**
+     * @brief Builds the masked-key index of all search words for all filters and offsets.
+     *
+     * @param search_words The search words.
+     * @param filters The MCS filters.
+     * @param alphabet The alphabet of the text, sets the packed key width.
+     * @param index The index to fill.
+     * @return int Returns 0 on success, or -1 if a filter is invalid.
+     */
+    int build_query_key_index(const vector<string>& search_words, const vector<string>& filters, const Alphabet& alphabet, QueryKeyIndex& index) {
+        index = QueryKeyIndex();
+        index.alphabet = alphabet;
+        index.symbol_bits = alphabet.bits_per_symbol();
+
+        for (const string& filter : filters) {
+            if (filter.size() > static_cast<size_t>(SEARCH_WORD_SIZE)) {
+                cerr << "[StreamingMCSSearch] Invalid filter " << filter << " - longer than a search word.\n";
+                return -1;
+            }
+
+            vector<uint8_t> ones;
+            for (size_t i = 0; i < filter.size(); ++i)
+                if (filter[i] == '1')
+                    ones.push_back(static_cast<uint8_t>(i));
+            index.filter_ones.push_back(ones);
+            index.filter_lengths.push_back(filter.size());
+        }
+
+        // Collect all (key, entry) pairs, then group them by key
+        vector<pair<uint64_t, QueryKeyEntry>> keyed_entries;
+        for (size_t word_index = 0; word_index < search_words.size(); ++word_index) {
+            const string& word = search_words[word_index];
+
+            for (size_t filter_id = 0; filter_id < filters.size(); ++filter_id) {
+                size_t filter_length = index.filter_lengths[filter_id];
+
+                for (size_t offset = 0; offset + filter_length <= word.size(); ++offset) {
+                    uint64_t key = pack_key(index, word.data() + offset, filter_id);
+                    keyed_entries.push_back({ key, { static_cast<uint32_t>(word_index), static_cast<uint16_t>(offset) } });
+                }
+            }
+        }
+
+        sort(keyed_entries.begin(), keyed_entries.end(), [](const pair<uint64_t, QueryKeyEntry>& a, const pair<uint64_t, QueryKeyEntry>& b) {
+            return a.first < b.first;
+        });
+
+        index.entries.reserve(keyed_entries.size());
+        for (size_t i = 0; i < keyed_entries.size(); ++i) {
+            if (i == 0 || keyed_entries[i].first != keyed_entries[i - 1].first)
+                index.ranges[keyed_entries[i].first] = { static_cast<uint32_t>(i), static_cast<uint32_t>(i) };
+            index.ranges[keyed_entries[i].first].second++;
+            index.entries.push_back(keyed_entries[i].second);
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Filters every window in [first_window, last_window) and verifies the candidates it hits.
+     *
+     * @param index The masked-key index of the search words.
+     * @param search_words The search words.
+     * @param text The text to stream.
+     * @param first_window First window start of the chunk.
+     * @param last_window One past the last window start of the chunk.
+     * @param hits The buffer of the calling worker to append the matches to (1-based positions).
+     */
+    static void stream_text_chunk(const QueryKeyIndex& index, const vector<string>& search_words, string_view text,
+        size_t first_window, size_t last_window, vector<WordHit>& hits) {
+        for (size_t window = first_window; window < last_window; ++window) {
+            for (size_t filter_id = 0; filter_id < index.filter_ones.size(); ++filter_id) {
+                auto it = index.ranges.find(pack_key(index, text.data() + window, filter_id));
+                if (it == index.ranges.end()) continue;
+
+                for (uint32_t e = it->second.first; e < it->second.second; ++e) {
+                    const QueryKeyEntry& entry = index.entries[e];
+                    const string& word = search_words[entry.word_index];
+                    if (window < entry.offset) continue;
+
+                    // Ensure we're not overflowing the text, same as the filters map searches
+                    size_t position_text = window - entry.offset;
+                    if (position_text + word.size() >= text.size()) continue;
+
+                    if (check_matches(text, position_text, word))
+                        hits.push_back({ entry.word_index, position_text + 1 });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Executes an MCS search by streaming the text once against the search words' masked keys.
+     *
+     * Instead of indexing the text (filters map), the masked keys of the search words are
+     * indexed, and every text window is filtered and looked up in that index. Every hit is
+     * a (word, alignment) candidate that is verified against the text. Results are the same
+     * as the standard MCS search.
+     *
+     * @return int Returns 0 on success, or -1 on any failure during input loading or saving.
+     */
+    int run_streaming_mcs_search() {
+        cout << "[StreamingMCSSearch] Starting streaming MCS search...\n";
+
+        // Load text, MCS filters and search words, all at once
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME, STANDARD_MCS_OUTPUT_FILENAME);
+        string_view text;
+        if (loader.wait_text(text) != 0 || text.size() < static_cast<size_t>(SEARCH_WORD_SIZE)) {
+            cerr << "[StreamingMCSSearch] Failed to load text - its empty or doesn`t exist.\n";
+            return -1;
+        }
+
+        const vector<string>* mcs_filters;
+        if (loader.wait_filters(mcs_filters) != 0) {
+            cerr << "[StreamingMCSSearch] Failed to load MCS filters - its empty or doens`t exist.\n";
+            return -1;
+        }
+
+        // The query index needs every search word up front
+        vector<string> search_words;
+        if (loader.wait_all_words(search_words) != 0) {
+            cerr << "[StreamingMCSSearch] Failed to load search words.\n";
+            return -1;
+        }
+
+        Alphabet alphabet;
+        if (Alphabet::load_current(alphabet) != 0) return -1;
+
+        auto start = steady_clock::now();
+
+        // --- Index the masked keys of the search words ---
+        QueryKeyIndex index;
+        if (build_query_key_index(search_words, *mcs_filters, alphabet, index) != 0) return -1;
+        cout << "[StreamingMCSSearch] Indexed " << index.entries.size() << " masked keys under "
+             << index.ranges.size() << " distinct keys, " << index.symbol_bits << " bits per symbol.\n";
+
+        // --- Stream the text in chunks of windows, in parallel ---
+        // Same windows as the filters map: every start of a SEARCH_WORD_SIZE window
+        size_t total_windows = text.size() - SEARCH_WORD_SIZE + 1;
+        size_t total_chunks = (total_windows + STREAMING_CHUNK_SIZE - 1) / STREAMING_CHUNK_SIZE;
+
+        vector<WordMatch> results;
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
+
+        cout << "[StreamingMCSSearch] Streaming " << total_windows << " windows on " << scheduler.threads_count() << " threads..\n";
+        scheduler.run(total_chunks, [&](unsigned worker, size_t chunk) {
+            size_t first_window = chunk * STREAMING_CHUNK_SIZE;
+            size_t last_window = min(total_windows, first_window + STREAMING_CHUNK_SIZE);
+            stream_text_chunk(index, search_words, text, first_window, last_window, thread_hits[worker]);
+        }, true);
+        size_t count_total_finds = merge_word_hits(thread_hits, search_words, results);
+
+        auto end = steady_clock::now();
+        duration<double> elapsed_seconds = end - start;
+        double seconds = elapsed_seconds.count();
+        Summary summary = { "Streaming Search", count_total_finds, seconds };
+        scheduler.print_stats("[StreamingMCSSearch]");
+
+        // Save results to file
+        int status = save_results(results, search_words, "Streaming MCS Search", without_line_break(text).size(), STREAMING_MCS_SEARCH_OUTPUT_FILENAME);
+        if (save_to_file(summary.to_lines(), STREAMING_MCS_SEARCH_SUMMARY_FILENAME, true) != 0)
+            cout << "[StreamingMCSSearch] Summary failed saving.\n";
+        else cout << "[StreamingMCSSearch] Summary file has saved to " << STREAMING_MCS_SEARCH_SUMMARY_FILENAME << "\n";
+
+        if (status == 0) cout << "[StreamingMCSSearch] MCS search complete with total finds " << count_total_finds << ". Results saved to " << STREAMING_MCS_SEARCH_OUTPUT_FILENAME << '\n';
+        return status;
+    }
+}
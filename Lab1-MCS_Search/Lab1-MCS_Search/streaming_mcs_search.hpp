@@ -0,0 +1,87 @@
+#ifndef STREAMING_MCS_SEARCH_HPP
+#define STREAMING_MCS_SEARCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include "WordMatch.hpp"
+#include "Summary.hpp"
+#include "utils.hpp"
+#include "result_file.hpp"
+#include "config.hpp"
+#include "naive_search.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "SearchInputLoader.hpp"
+#include "Alphabet.hpp"
+
+namespace StreamingMCSSearch {
+
+    /**
+     * @brief A search word waiting for a masked key - the word and the offset the key was taken at.
+     */
+    struct QueryKeyEntry {
+        uint32_t word_index;
+        uint16_t offset;
+    };
+
+    /**
+     * @brief Index of every (filter, offset) masked key of the search words, keyed by packed key.
+     *
+     * A packed key holds the filter id and the alphabet codes of the kept characters, in
+     * `symbol_bits` bits each. Entries of the same key are stored contiguously, and `ranges`
+     * maps a key to its [begin, end) range.
+     */
+    struct QueryKeyIndex {
+        Alphabet alphabet;
+        unsigned symbol_bits = 1;            // Alphabet::bits_per_symbol() of the alphabet
+        vector<vector<uint8_t>> filter_ones; // Kept positions of every filter
+        vector<size_t> filter_lengths;
+        vector<QueryKeyEntry> entries;
+        std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> ranges;
+    };
+
+    /**
+     * @brief Packs the characters a filter keeps, starting at `chars`, together with the filter id.
+     *
+     * Keys whose kept characters take more than 64 bits wrap around and may collide, and so do
+     * characters outside the alphabet. A collision only produces an extra candidate, which
+     * verification rejects.
+     *
+     * @param index The index holding the filters and the alphabet.
+     * @param chars First character of the filtered window.
+     * @param filter_id Index of the filter.
+     * @return uint64_t The packed key.
+     */
+    inline uint64_t pack_key(const QueryKeyIndex& index, const char* chars, size_t filter_id) {
+        const uint64_t code_mask = (uint64_t(1) << index.symbol_bits) - 1;
+        uint64_t key = filter_id + 1;
+        for (uint8_t i : index.filter_ones[filter_id])
+            key = (key << index.symbol_bits) | (index.alphabet.code(chars[i]) & code_mask);
+        return key;
+    }
+
+    /**
+     * @brief Builds the masked-key index of all search words for all filters and offsets.
+     *
+     * @param search_words The search words.
+     * @param filters The MCS filters.
+     * @param alphabet The alphabet of the text, sets the packed key width.
+     * @param index The index to fill.
+     * @return int Returns 0 on success, or -1 if a filter is invalid.
+     */
+    int build_query_key_index(const vector<string>& search_words, const vector<string>& filters, const Alphabet& alphabet, QueryKeyIndex& index);
+
+    /**
+     * @brief Executes an MCS search by streaming the text once against the search words' masked keys.
+     *
+     * Instead of indexing the text (filters map), the masked keys of the search words are
+     * indexed, and every text window is filtered and looked up in that index. Every hit is
+     * a (word, alignment) candidate that is verified against the text. Results are the same
+     * as the standard MCS search.
+     *
+     * @return int Returns 0 on success, or -1 on any failure during input loading or saving.
+     */
+    int run_streaming_mcs_search();
+}
+
+#endif
@@ -0,0 +1,155 @@
+#include "telemetry.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace chrono;
+using namespace Config;
+
+namespace Telemetry {
+
+    static const size_t MAX_FINISHED_COUNTERS = 32; // Finished counters kept for snapshot_counters()
+
+    /**
+     * @brief All counters of the session and the reporter thread rendering the active ones.
+     */
+    static struct Registry {
+        mutex lock;
+        condition_variable wake;
+        vector<shared_ptr<CounterState>> counters;
+        size_t active = 0;
+        thread reporter;
+        uint64_t reporter_generation = 0;   // Bumped when the reporter must stop
+        size_t last_line_width = 0;
+    } registry;
+
+    static CounterSnapshot take_snapshot(const CounterState& state, steady_clock::time_point now) {
+        CounterSnapshot snapshot;
+        snapshot.name = state.name;
+        snapshot.done = state.done.load(memory_order_relaxed);
+        snapshot.total = state.total;
+        snapshot.finished = state.finished;
+        snapshot.elapsed_seconds = duration<double>((state.finished ? state.end : now) - state.start).count();
+        snapshot.items_per_second = snapshot.elapsed_seconds > 0 ? snapshot.done / snapshot.elapsed_seconds : 0;
+
+        if (snapshot.finished || snapshot.done >= snapshot.total) snapshot.eta_seconds = 0;
+        else if (snapshot.items_per_second > 0) snapshot.eta_seconds = (snapshot.total - snapshot.done) / snapshot.items_per_second;
+        else snapshot.eta_seconds = -1;
+        return snapshot;
+    }
+
+    /**
+     * @brief Formats one counter, e.g. "Search words 45.20% | 1234/s | ETA 3.2s".
+     */
+    static void render(ostringstream& out, const CounterSnapshot& snapshot) {
+        double percent = snapshot.total > 0 ? min(100.0, 100.0 * snapshot.done / snapshot.total) : 100.0;
+        out << snapshot.name << ' ' << fixed << setprecision(2) << percent << "% | "
+            << setprecision(0) << snapshot.items_per_second << "/s | " << setprecision(1);
+        if (snapshot.finished) out << snapshot.elapsed_seconds << 's';
+        else if (snapshot.eta_seconds >= 0) out << "ETA " << snapshot.eta_seconds << 's';
+        else out << "ETA -";
+    }
+
+    /**
+     * @brief Overwrites the current progress line, padding over a longer previous one. Needs registry.lock.
+     */
+    static void print_line(const string& line, bool last) {
+        size_t width = line.size();
+        cout << '\r' << line;
+        if (registry.last_line_width > width) cout << string(registry.last_line_width - width, ' ');
+        registry.last_line_width = last ? 0 : width;
+        if (last) cout << endl;
+        else cout << flush;
+    }
+
+    /**
+     * @brief Reporter thread body - renders all active counters on one line until its generation is stopped.
+     */
+    static void report_loop(uint64_t generation) {
+        unique_lock<mutex> lock(registry.lock);
+        while (true) {
+            registry.wake.wait_for(lock, milliseconds(PROGRESS_REPORT_INTERVAL_MS));
+            if (registry.reporter_generation != generation) return;
+
+            ostringstream out;
+            out << "[Progress] ";
+            bool first = true;
+            steady_clock::time_point now = steady_clock::now();
+            for (const shared_ptr<CounterState>& state : registry.counters) {
+                if (state->finished) continue;
+                if (!first) out << " || ";
+                render(out, take_snapshot(*state, now));
+                first = false;
+            }
+            if (!first) print_line(out.str(), false);
+        }
+    }
+
+    ProgressCounter::ProgressCounter(const string& name, uint64_t total) : state(make_shared<CounterState>()) {
+        state->name = name;
+        state->total = total;
+        state->start = steady_clock::now();
+
+        lock_guard<mutex> lock(registry.lock);
+        registry.counters.push_back(state);
+        if (registry.active++ == 0)
+            registry.reporter = thread(report_loop, registry.reporter_generation);
+    }
+
+    ProgressCounter::~ProgressCounter() {
+        finish();
+    }
+
+    /**
+     * @brief Stops counting and prints the final progress line. Called by the destructor if not before.
+     */
+    void ProgressCounter::finish() {
+        thread stopped_reporter;
+        {
+            lock_guard<mutex> lock(registry.lock);
+            if (state->finished) return;
+            state->end = steady_clock::now();
+            state->finished = true;
+
+            ostringstream out;
+            out << "[Progress] ";
+            render(out, take_snapshot(*state, state->end));
+            print_line(out.str(), true);
+
+            // Keep only the latest finished counters around for the snapshots
+            size_t finished_count = registry.counters.size() - (registry.active - 1);
+            if (finished_count > MAX_FINISHED_COUNTERS) {
+                auto oldest = find_if(registry.counters.begin(), registry.counters.end(),
+                    [](const shared_ptr<CounterState>& counter) { return counter->finished; });
+                registry.counters.erase(oldest);
+            }
+
+            if (--registry.active == 0) {
+                registry.reporter_generation++;
+                stopped_reporter = move(registry.reporter);
+            }
+        }
+        registry.wake.notify_all();
+        if (stopped_reporter.joinable()) stopped_reporter.join();
+    }
+
+    /**
+     * @brief Returns the active counters and the most recently finished ones, oldest first.
+     *
+     * @return std::vector<CounterSnapshot> One snapshot per counter.
+     */
+    vector<CounterSnapshot> snapshot_counters() {
+        lock_guard<mutex> lock(registry.lock);
+        vector<CounterSnapshot> snapshots;
+        steady_clock::time_point now = steady_clock::now();
+        for (const shared_ptr<CounterState>& state : registry.counters)
+            snapshots.push_back(take_snapshot(*state, now));
+        return snapshots;
+    }
+}
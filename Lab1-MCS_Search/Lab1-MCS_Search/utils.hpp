@@ -10,12 +10,39 @@
 #include <string>
 #include <chrono>
 #include <set>
+#include <thread>
+#include <string_view>
 
 #include "WordMatch.hpp"
 #include "config.hpp"
+#include "MappedFile.hpp"
+#include "MappedOutputFile.hpp"
+#include "ResultWriter.hpp"
+#include "MatchAccumulator.hpp"
+#include "telemetry.hpp"
 
 namespace Utils {
 
+    /**
+     * @brief Read-only view of a whole text file, mapped into memory without copying.
+     *
+     * `text` stays valid as long as the object lives.
+     */
+    struct MappedText {
+        MappedFile file;
+        std::string_view text;
+    };
+
+    /**
+     * @brief Read-only views of the non-empty lines of a file mapped into memory.
+     *
+     * `lines` stay valid as long as the object lives.
+     */
+    struct MappedLines {
+        MappedFile file;
+        vector<std::string_view> lines;
+    };
+
     extern bool has_generated_mcs;
     extern bool has_generated_text;
     extern bool has_generated_search_words;
@@ -61,6 +88,48 @@ namespace Utils {
      */
     std::string read_text_from_file(const std::string& filename, bool should_print_log = true);
 
+    /**
+     * @brief Ensures the filename has a .txt extension.
+     *
+     * @param filename The original filename
+     * @return string Modified filename with .txt if missing
+     */
+    std::string ensure_txt_extension(const std::string& filename);
+
+    /**
+     * @brief Maps a text file into memory and exposes it as a read-only view.
+     *
+     * A file longer than the largest Config::TextPosition is rejected, so every position in
+     * it can be stored and cast to a TextPosition without being truncated.
+     *
+     * @param filename The input filename
+     * @param mapped The mapped text to fill (empty on failure)
+     * @param should_print_log Flag indicating if should print logs. Default to true.
+     * @param prefault Flag indicating if all pages should be read in now, on the calling thread. Default to Config::PREFAULT_MAPPED_FILES.
+     * @return int 0 on success, -1 on failure (missing, empty or too long file)
+     */
+    int map_text_from_file(const std::string& filename, MappedText& mapped, bool should_print_log = true, bool prefault = Config::PREFAULT_MAPPED_FILES);
+
+    /**
+     * @brief Returns the text without the line break a text file ends with.
+     *
+     * @param text The contents of a text file.
+     * @return string_view The text up to its trailing newline and carriage return characters.
+     */
+    std::string_view without_line_break(std::string_view text);
+
+    /**
+     * @brief Maps a newline-separated file into memory and slices it into line views.
+     *
+     * Empty lines are skipped and trailing carriage returns are removed, like read_lines_from_file.
+     *
+     * @param filename Name of the file to read.
+     * @param mapped The mapped lines to fill (no lines on failure)
+     * @param should_print_log Flag indicating if should print logs. Default to true.
+     * @return int 0 on success, -1 on failure (missing or empty file)
+     */
+    int map_lines_from_file(const std::string& filename, MappedLines& mapped, bool should_print_log = true);
+
     /**
      * @brief Reads a newline-separated list of strings from a file.
      *
@@ -71,31 +140,57 @@ namespace Utils {
     vector<std::string> read_lines_from_file(const std::string& filename, bool should_print_log = true);
 
     /**
-     * @brief Converts WordMatch results into printable lines for file saving.
+     * @brief Opens a results file for streaming, with the same naming and overwrite rules as save_to_file.
+     *
+     * @param writer The writer to open.
+     * @param filename The target filename
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
+     */
+    int open_result_file(ResultWriter& writer, const std::string& filename, bool overwrite = false);
+
+    /**
+     * @brief Creates a file of a known size and maps it for writing, with the same naming and overwrite rules as save_to_file.
+     *
+     * @param output The output mapping to create.
+     * @param filename The target filename
+     * @param size The size of the file in bytes.
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
+     */
+    int create_mapped_output(MappedOutputFile& output, const std::string& filename, size_t size, bool overwrite = false);
+
+    /**
+     * @brief Streams WordMatch results to a file, formatting them straight into the writer's buffers.
      *
      * @param matches Vector of WordMatch objects
-     * @return vector<string> Formatted output lines
+     * @param words The words the matches' word ids refer to.
+     * @param filename The target filename
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
      */
-    vector<std::string> convert_matches_to_lines(const vector<WordMatch>& matches);
+    int save_matches_to_file(const vector<WordMatch>& matches, const vector<std::string>& words, const std::string& filename, bool overwrite = false);
 
     /**
-     * @brief Prints progress as a percentage with two decimal digits, in-place on the same line.
-     *        Progress updates are throttled to avoid excessive output.
+     * @brief Returns the number of worker threads to use - NUMBER_OF_THREADS, or all hardware threads when it is 0.
      *
-     * @param current Current iteration (0-based).
-     * @param total Total number of iterations (must be > 0).
+     * @return unsigned Number of threads (at least 1).
      */
-    void print_progress(int current, int total);
+    unsigned get_number_of_threads();
 
     /**
-     * @brief Inserts a WordMatch into the set, or updates the existing match with a new position.
+     * @brief Merges per-thread hit buffers into the results, in word order with sorted positions.
+     *
+     * Hits are accumulated per word id and sorted once per word, on as many threads as there
+     * are buffers. The results and the returned count are the same for any number of threads.
+     * The buffers are emptied.
      *
-     * @param result_set Reference to the set of WordMatch entries.
-     * @param word The word being matched.
-     * @param pos The position to add to the word's match list.
-     * @return true if the position was added successfully, false if it already existed.
+     * @param thread_hits Hit buffers of all worker threads.
+     * @param search_words The search words the hits' word indices refer to.
+     * @param results The vector to append the matches to (one WordMatch per distinct word).
+     * @return size_t Number of distinct (word, position) matches.
      */
-     bool insert_or_update_match(std::set<WordMatch>& result_set, const std::string& word, size_t pos);
+    size_t merge_word_hits(vector<vector<WordHit>>& thread_hits, const vector<std::string>& search_words, vector<WordMatch>& results);
 };
 
 #endif
\ No newline at end of file
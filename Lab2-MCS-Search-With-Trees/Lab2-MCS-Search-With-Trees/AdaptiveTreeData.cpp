@@ -0,0 +1,239 @@
+#include "AdaptiveTreeData.hpp"
+
+using namespace std;
+
+// Definition of the global variable
+AdaptiveTreeData adaptive_tree_data;
+
+namespace {
+    uint32_t make_ref(uint32_t type, size_t index) {
+        return (type << AdaptiveTreeData::TYPE_SHIFT) | static_cast<uint32_t>(index);
+    }
+}
+
+/**
+ * @brief Number of '$' characters consumed before the referenced node branches.
+ */
+uint8_t AdaptiveTreeData::dollar_prefix(uint32_t ref) const {
+    uint32_t index = ref & INDEX_MASK;
+    switch (ref >> TYPE_SHIFT) {
+    case NODE4: return nodes4[index].dollar_prefix;
+    case NODE16: return nodes16[index].dollar_prefix;
+    default: return nodes_full[index].dollar_prefix;
+    }
+}
+
+void AdaptiveTreeData::set_dollar_prefix(uint32_t ref, size_t dollar_prefix) {
+    uint32_t index = ref & INDEX_MASK;
+    switch (ref >> TYPE_SHIFT) {
+    case NODE4: nodes4[index].dollar_prefix = static_cast<uint8_t>(dollar_prefix); break;
+    case NODE16: nodes16[index].dollar_prefix = static_cast<uint8_t>(dollar_prefix); break;
+    default: nodes_full[index].dollar_prefix = static_cast<uint8_t>(dollar_prefix); break;
+    }
+}
+
+/**
+ * @brief Returns the child of a node for a letter index (below alphabet.fanout()), or EMPTY if there is none.
+ */
+uint32_t AdaptiveTreeData::find_child(uint32_t ref, int idx) const {
+    uint32_t index = ref & INDEX_MASK;
+    switch (ref >> TYPE_SHIFT) {
+    case NODE4: {
+        const AdaptiveNode4& node = nodes4[index];
+        for (uint8_t i = 0; i < node.count; ++i)
+            if (node.keys[i] == idx) return node.children[i];
+        return EMPTY;
+    }
+    case NODE16: {
+        const AdaptiveNode16& node = nodes16[index];
+        for (uint8_t i = 0; i < node.count; ++i)
+            if (node.keys[i] == idx) return node.children[i];
+        return EMPTY;
+    }
+    default:
+        return full_children[index][idx];
+    }
+}
+
+/**
+ * @brief Returns the address of the child slot of a node for a letter index, or nullptr if there is none.
+ */
+uint32_t* AdaptiveTreeData::child_slot(uint32_t ref, int idx) {
+    uint32_t index = ref & INDEX_MASK;
+    switch (ref >> TYPE_SHIFT) {
+    case NODE4: {
+        AdaptiveNode4& node = nodes4[index];
+        for (uint8_t i = 0; i < node.count; ++i)
+            if (node.keys[i] == idx) return &node.children[i];
+        return nullptr;
+    }
+    case NODE16: {
+        AdaptiveNode16& node = nodes16[index];
+        for (uint8_t i = 0; i < node.count; ++i)
+            if (node.keys[i] == idx) return &node.children[i];
+        return nullptr;
+    }
+    default: {
+        uint32_t* children = full_children[index];
+        return children[idx] == EMPTY ? nullptr : &children[idx];
+    }
+    }
+}
+
+/**
+ * @brief Adds a child to the node referenced by `ref`, growing the node to the next kind when it is full.
+ *
+ * @param ref Address of the reference to the node (updated when the node grows).
+ * @param idx Letter index of the new child.
+ * @param child The child reference to store.
+ * @return uint32_t* Address of the slot holding the new child.
+ */
+uint32_t* AdaptiveTreeData::add_child(uint32_t* ref, int idx, uint32_t child) {
+    uint32_t index = *ref & INDEX_MASK;
+    switch (*ref >> TYPE_SHIFT) {
+    case NODE4: {
+        AdaptiveNode4& node = nodes4[index];
+        if (node.count < 4) {
+            node.keys[node.count] = static_cast<uint8_t>(idx);
+            node.children[node.count] = child;
+            return &node.children[node.count++];
+        }
+
+        // Full - grow into a 16-children node, or straight into a full node when the alphabet is that small
+        if (alphabet.fanout() <= 16) {
+            *ref = grow_to_full(node.dollar_prefix, node.count, node.keys, node.children);
+            return add_child(ref, idx, child);
+        }
+        AdaptiveNode16 grown{};
+        grown.dollar_prefix = node.dollar_prefix;
+        grown.count = node.count;
+        copy(begin(node.keys), end(node.keys), grown.keys);
+        copy(begin(node.children), end(node.children), grown.children);
+        *ref = make_ref(NODE16, nodes16.push_back(grown));
+        return add_child(ref, idx, child);
+    }
+    case NODE16: {
+        AdaptiveNode16& node = nodes16[index];
+        if (node.count < 16) {
+            node.keys[node.count] = static_cast<uint8_t>(idx);
+            node.children[node.count] = child;
+            return &node.children[node.count++];
+        }
+
+        // Full - grow into a node with a slot for every letter
+        *ref = grow_to_full(node.dollar_prefix, node.count, node.keys, node.children);
+        return add_child(ref, idx, child);
+    }
+    default: {
+        uint32_t* children = full_children[index];
+        children[idx] = child;
+        nodes_full[index].count++;
+        return &children[idx];
+    }
+    }
+}
+
+/**
+ * @brief Creates a full node holding the (letter index, child) pairs of a smaller node.
+ *
+ * @return uint32_t Reference to the new node.
+ */
+uint32_t AdaptiveTreeData::grow_to_full(uint8_t dollar_prefix, uint8_t count, const uint8_t* keys, const uint32_t* children) {
+    AdaptiveNodeFull grown{};
+    grown.dollar_prefix = dollar_prefix;
+    grown.count = count;
+    uint32_t index = nodes_full.push_back(grown);
+
+    uint32_t* grown_children = full_children[full_children.push_back(EMPTY)];
+    for (uint8_t i = 0; i < count; ++i)
+        grown_children[keys[i]] = children[i];
+    return make_ref(NODE_FULL, index);
+}
+
+uint32_t AdaptiveTreeData::new_node4(size_t dollar_prefix) {
+    AdaptiveNode4 node{};
+    node.dollar_prefix = static_cast<uint8_t>(dollar_prefix);
+    return make_ref(NODE4, nodes4.push_back(node));
+}
+
+/**
+ * @brief Inserts a filtered word, creating or growing nodes as needed.
+ *
+ * @param key The filtered word ('$' for masked positions).
+ * @return uint32_t The leaf index of the key, or EMPTY if a node pool ran out of 32-bit references.
+ */
+uint32_t AdaptiveTreeData::insert(const string& key) {
+    if (key.empty() || nodes4.size() >= INDEX_MASK || nodes16.size() >= INDEX_MASK ||
+        nodes_full.size() >= INDEX_MASK || leaves_count >= INDEX_MASK) {
+        return EMPTY;
+    }
+
+    if (root == EMPTY) root = new_node4(0);
+
+    const size_t last = key.size() - 1;
+    uint32_t* ref = &root;
+    size_t depth = 0;
+
+    while (true) {
+        // Walk the compressed '$' run of the node
+        size_t prefix = dollar_prefix(*ref);
+        size_t i = 0;
+        while (i < prefix && depth + i < last && key[depth + i] == '$') ++i;
+
+        if (i < prefix) {
+            // Key leaves the run - split: a new node branches at depth + i, the old node continues under '$'
+            uint32_t old_ref = *ref;
+            set_dollar_prefix(old_ref, prefix - i - 1);
+            uint32_t split = new_node4(i);
+            add_child(&split, alphabet.mask_code(), old_ref);
+            *ref = split;
+            prefix = i;
+        }
+        depth += prefix;
+
+        int idx = alphabet.index(key[depth]);
+        uint32_t* slot = child_slot(*ref, idx);
+
+        if (depth == last) {
+            // Last character - store a leaf
+            if (slot == nullptr) slot = add_child(ref, idx, LEAF_FLAG | leaves_count++);
+            return leaf_index(*slot);
+        }
+
+        if (slot == nullptr) {
+            // New branch - compress the '$' run that follows this character into the new node
+            size_t run = 0;
+            while (run < UINT8_MAX && depth + 1 + run < last && key[depth + 1 + run] == '$') ++run;
+            slot = add_child(ref, idx, new_node4(run));
+        }
+
+        // Keys never prefix each other (every filter has the same number of ones)
+        if (is_leaf(*slot)) return leaf_index(*slot);
+
+        ref = slot;
+        depth++;
+    }
+}
+
+/**
+ * @brief Forgets all nodes and sets the alphabet of the keys inserted next.
+ */
+void AdaptiveTreeData::reset(const Alphabet& key_alphabet) {
+    clear();
+    alphabet = key_alphabet;
+    full_children.reset(alphabet.fanout());
+}
+
+/**
+ * @brief Releases all nodes and leaves at once.
+ */
+void AdaptiveTreeData::clear() {
+    nodes4.clear();
+    nodes16.clear();
+    nodes_full.clear();
+    full_children.clear();
+    leaves_count = 0;
+    postings.clear();
+    arena.release();
+    root = EMPTY;
+}
@@ -0,0 +1,112 @@
+#ifndef ADAPTIVE_TREE_DATA_HPP
+#define ADAPTIVE_TREE_DATA_HPP
+
+#include <cstdint>
+#include <string>
+#include "config.hpp"
+#include "Arena.hpp"
+#include "PostingLists.hpp"
+#include "Alphabet.hpp"
+
+/**
+ * @brief Adaptive-size nodes of the alternative MCS tree.
+ *
+ * Small nodes keep (letter index, child) pairs and are grown to the next kind
+ * only when they fill up. `dollar_prefix` is the number of '$' characters every key
+ * passing through the node has right before the node branches (path compression).
+ * A full node has a slot for every symbol of the alphabet and '$', kept as its row
+ * of AdaptiveTreeData::full_children.
+ */
+struct AdaptiveNode4 {
+    uint8_t dollar_prefix;
+    uint8_t count;
+    uint8_t keys[4];
+    uint32_t children[4];
+};
+
+struct AdaptiveNode16 {
+    uint8_t dollar_prefix;
+    uint8_t count;
+    uint8_t keys[16];
+    uint32_t children[16];
+};
+
+struct AdaptiveNodeFull {
+    uint8_t dollar_prefix;
+    uint16_t count;
+};
+
+/**
+ * @brief Adaptive radix tree over filtered words - the alternative to TreeDataArray.
+ *
+ * A child reference is 32 bits: the top bit marks a leaf index, the next two bits hold
+ * the node kind and the remaining bits index the pool of that kind.
+ */
+struct AdaptiveTreeData {
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+    static constexpr uint32_t LEAF_FLAG = 1u << 31;
+    static constexpr uint32_t TYPE_SHIFT = 29;
+    static constexpr uint32_t INDEX_MASK = (1u << TYPE_SHIFT) - 1;
+    enum NodeType : uint32_t { NODE4 = 0, NODE16 = 1, NODE_FULL = 2 };
+
+    Arena arena;
+    Alphabet alphabet;
+    SlabArray<AdaptiveNode4> nodes4{ arena };
+    SlabArray<AdaptiveNode16> nodes16{ arena };
+    SlabArray<AdaptiveNodeFull> nodes_full{ arena };
+    SlabRows<uint32_t> full_children{ arena };
+    uint32_t leaves_count = 0;
+    PostingLists postings;
+    uint32_t root = EMPTY;
+
+    bool empty() const {
+        return root == EMPTY;
+    }
+
+    static bool is_leaf(uint32_t ref) {
+        return ref != EMPTY && (ref & LEAF_FLAG) != 0;
+    }
+
+    static uint32_t leaf_index(uint32_t ref) {
+        return ref & ~LEAF_FLAG;
+    }
+
+    /**
+     * @brief Number of '$' characters consumed before the referenced node branches.
+     */
+    uint8_t dollar_prefix(uint32_t ref) const;
+
+    /**
+     * @brief Returns the child of a node for a letter index (below alphabet.fanout()), or EMPTY if there is none.
+     */
+    uint32_t find_child(uint32_t ref, int idx) const;
+
+    /**
+     * @brief Forgets all nodes and sets the alphabet of the keys inserted next.
+     */
+    void reset(const Alphabet& key_alphabet);
+
+    /**
+     * @brief Inserts a filtered word, creating or growing nodes as needed.
+     *
+     * @param key The filtered word ('$' for masked positions).
+     * @return uint32_t The leaf index of the key, or EMPTY if a node pool ran out of 32-bit references.
+     */
+    uint32_t insert(const std::string& key);
+
+    /**
+     * @brief Releases all nodes and leaves at once.
+     */
+    void clear();
+
+private:
+    uint32_t new_node4(size_t dollar_prefix);
+    void set_dollar_prefix(uint32_t ref, size_t dollar_prefix);
+    uint32_t* child_slot(uint32_t ref, int idx);
+    uint32_t* add_child(uint32_t* ref, int idx, uint32_t child);
+    uint32_t grow_to_full(uint8_t dollar_prefix, uint8_t count, const uint8_t* keys, const uint32_t* children);
+};
+
+extern AdaptiveTreeData adaptive_tree_data;
+
+#endif
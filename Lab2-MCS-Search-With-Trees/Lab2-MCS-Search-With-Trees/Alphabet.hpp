@@ -0,0 +1,118 @@
+#ifndef ALPHABET_HPP
+#define ALPHABET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Dense remapping of the symbols a text is made of to the codes 0..size()-1.
+ *
+ * Codes follow the byte order of the symbols. Trees and packed keys work on the codes, so
+ * their node fanout and key width follow the real alphabet instead of the 'a'..'z' range.
+ * The mask character '$' is never a symbol - in tree keys it takes the code mask_code(),
+ * right after the symbols.
+ */
+class Alphabet {
+public:
+    static constexpr uint8_t UNMAPPED = UINT8_MAX;      // Code of a byte that is not a symbol
+    static constexpr char MASK = '$';                   // Masked position of a filtered key
+    static constexpr size_t MAX_SYMBOLS = UINT8_MAX - 1; // Symbols and the mask code stay below UNMAPPED
+
+    /**
+     * @brief Creates an alphabet of the given symbols (duplicates and the mask character are ignored).
+     */
+    explicit Alphabet(std::string_view symbols = std::string_view());
+
+    /**
+     * @brief Creates the alphabet of the generated texts, the letters `first`..`last`.
+     */
+    static Alphabet letters(char first, char last);
+
+    /**
+     * @brief Code of a text or word character, UNMAPPED if it is not a symbol.
+     */
+    uint8_t code(char symbol) const {
+        return codes[static_cast<unsigned char>(symbol)];
+    }
+
+    /**
+     * @brief Pointer slot of a filtered key character - its code, or mask_code() for '$'.
+     */
+    int index(char key_char) const {
+        return key_char == MASK ? mask_code() : code(key_char);
+    }
+
+    /**
+     * @brief Code of the mask character in tree keys.
+     */
+    int mask_code() const {
+        return static_cast<int>(symbols_list.size());
+    }
+
+    /**
+     * @brief Number of symbols.
+     */
+    size_t size() const {
+        return symbols_list.size();
+    }
+
+    /**
+     * @brief Number of children of a full tree node - every symbol and the mask.
+     */
+    size_t fanout() const {
+        return symbols_list.size() + 1;
+    }
+
+    /**
+     * @brief Bits needed to pack one symbol code (at least 1).
+     */
+    unsigned bits_per_symbol() const;
+
+    /**
+     * @brief The symbols, in code order.
+     */
+    const std::string& symbols() const {
+        return symbols_list;
+    }
+
+    /**
+     * @brief Checks that every character of the text is a symbol.
+     */
+    bool encodes(std::string_view text) const;
+
+    /**
+     * @brief 64-bit FNV-1a hash of the symbols, ties saved trees to the alphabet they were built with.
+     */
+    uint64_t checksum() const;
+
+    /**
+     * @brief Symbols as printable text, non-printable bytes escaped as \xNN.
+     */
+    std::string printable() const;
+
+    /**
+     * @brief Saves the symbols to a binary alphabet file.
+     *
+     * @param filename The target filename.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save(const std::string& filename) const;
+
+    /**
+     * @brief Loads the alphabet of the current text - Config::ALPHABET_FILENAME, or the letters
+     *        Config::Y_LETTER..'z' of the generated texts when that file does not exist.
+     *
+     * @param alphabet The alphabet to fill.
+     * @return int 0 on success, -1 if the alphabet file is corrupted.
+     */
+    static int load_current(Alphabet& alphabet);
+
+private:
+    std::array<uint8_t, 256> codes;
+    std::string symbols_list;
+};
+
+#endif
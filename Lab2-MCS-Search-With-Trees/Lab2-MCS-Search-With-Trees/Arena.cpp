@@ -0,0 +1,61 @@
+#include "Arena.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+    const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    size_t round_up(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+/**
+ * @brief Allocates uninitialized memory from the current block, opening a new block when needed.
+ *
+ * @param size Number of bytes to allocate.
+ * @param alignment Required alignment (power of two).
+ * @return void* Pointer to the allocated memory.
+ */
+void* Arena::allocate(size_t size, size_t alignment) {
+    char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(cursor), alignment));
+
+    if (cursor == nullptr || aligned + size > end) {
+        // Open a new block - oversized requests get a block of their own
+        size_t new_block_size = round_up(std::max(block_size, size + alignment), HUGE_PAGE_SIZE);
+        char* data = static_cast<char*>(::operator new(new_block_size, std::align_val_t(HUGE_PAGE_SIZE)));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (Config::USE_HUGE_PAGES)
+            madvise(data, new_block_size, MADV_HUGEPAGE);
+#endif
+
+        blocks.push_back({ data, new_block_size });
+        reserved += new_block_size;
+        cursor = data;
+        end = data + new_block_size;
+        aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(cursor), alignment));
+    }
+
+    cursor = aligned + size;
+    used += size;
+    return aligned;
+}
+
+/**
+ * @brief Frees every block owned by the arena in one shot.
+ */
+void Arena::release() {
+    for (const Block& block : blocks)
+        ::operator delete(block.data, std::align_val_t(HUGE_PAGE_SIZE));
+
+    std::vector<Block>().swap(blocks);
+    cursor = nullptr;
+    end = nullptr;
+    reserved = 0;
+    used = 0;
+}
@@ -0,0 +1,181 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+
+/**
+ * @brief Bump-pointer allocator that owns large blocks of memory and frees them all at once.
+ *
+ * Objects allocated from the arena are never destroyed one by one, so only trivially
+ * destructible types should be placed in it. Blocks are aligned to 2MB so the kernel can
+ * back them with transparent huge pages when Config::USE_HUGE_PAGES is set (Linux only).
+ */
+class Arena {
+public:
+    explicit Arena(size_t block_size = Config::ARENA_BLOCK_SIZE) : block_size(block_size) {}
+    ~Arena() { release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Allocates uninitialized memory from the current block, opening a new block when needed.
+     *
+     * @param size Number of bytes to allocate.
+     * @param alignment Required alignment (power of two).
+     * @return void* Pointer to the allocated memory.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Frees every block owned by the arena in one shot.
+     */
+    void release();
+
+    /**
+     * @brief Total bytes requested from the system.
+     */
+    size_t bytes_reserved() const { return reserved; }
+
+    /**
+     * @brief Total bytes handed out by allocate().
+     */
+    size_t bytes_used() const { return used; }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    size_t block_size;
+    std::vector<Block> blocks;
+    char* cursor = nullptr;
+    char* end = nullptr;
+    size_t reserved = 0;
+    size_t used = 0;
+};
+
+/**
+ * @brief Index-addressed array whose elements live in fixed-size slabs taken from an Arena.
+ *
+ * Growing never moves existing elements (unlike std::vector), and all memory is released
+ * together with the arena.
+ */
+template <typename T, size_t SLAB_SHIFT = 16>
+class SlabArray {
+    static_assert(std::is_trivially_destructible<T>::value, "SlabArray elements are never destroyed");
+
+public:
+    static constexpr size_t SLAB_SIZE = size_t(1) << SLAB_SHIFT;
+
+    explicit SlabArray(Arena& arena) : arena(&arena) {}
+
+    /**
+     * @brief Appends a value and returns its index.
+     */
+    uint32_t push_back(const T& value) {
+        if ((count & (SLAB_SIZE - 1)) == 0) {
+            slabs.push_back(static_cast<T*>(arena->allocate(sizeof(T) * SLAB_SIZE, alignof(T))));
+        }
+        new (&slabs[count >> SLAB_SHIFT][count & (SLAB_SIZE - 1)]) T(value);
+        return static_cast<uint32_t>(count++);
+    }
+
+    T& operator[](size_t index) {
+        return slabs[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)];
+    }
+
+    const T& operator[](size_t index) const {
+        return slabs[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)];
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    /**
+     * @brief Forgets all elements. The memory itself belongs to the arena.
+     */
+    void clear() {
+        std::vector<T*>().swap(slabs);
+        count = 0;
+    }
+
+private:
+    Arena* arena;
+    std::vector<T*> slabs;
+    size_t count = 0;
+};
+
+/**
+ * @brief Index-addressed rows of `width` elements each, where the width is only known at run time.
+ *
+ * Same slab layout as SlabArray, with SLAB_ROWS rows stored contiguously per slab.
+ */
+template <typename T, size_t SLAB_SHIFT = 12>
+class SlabRows {
+    static_assert(std::is_trivially_destructible<T>::value, "SlabRows elements are never destroyed");
+
+public:
+    static constexpr size_t SLAB_ROWS = size_t(1) << SLAB_SHIFT;
+
+    explicit SlabRows(Arena& arena) : arena(&arena) {}
+
+    /**
+     * @brief Sets the number of elements per row. Forgets all rows.
+     */
+    void reset(size_t row_width) {
+        clear();
+        width = row_width;
+    }
+
+    /**
+     * @brief Appends a row with every element set to `value` and returns its index.
+     */
+    uint32_t push_back(const T& value) {
+        if ((count & (SLAB_ROWS - 1)) == 0) {
+            slabs.push_back(static_cast<T*>(arena->allocate(sizeof(T) * width * SLAB_ROWS, alignof(T))));
+        }
+        T* row = (*this)[count];
+        for (size_t i = 0; i < width; ++i) new (&row[i]) T(value);
+        return static_cast<uint32_t>(count++);
+    }
+
+    T* operator[](size_t index) {
+        return slabs[index >> SLAB_SHIFT] + (index & (SLAB_ROWS - 1)) * width;
+    }
+
+    const T* operator[](size_t index) const {
+        return slabs[index >> SLAB_SHIFT] + (index & (SLAB_ROWS - 1)) * width;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    size_t row_width() const {
+        return width;
+    }
+
+    /**
+     * @brief Forgets all rows. The memory itself belongs to the arena.
+     */
+    void clear() {
+        std::vector<T*>().swap(slabs);
+        count = 0;
+    }
+
+private:
+    Arena* arena;
+    std::vector<T*> slabs;
+    size_t width = 1;
+    size_t count = 0;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef CANDIDATE_SET_HPP
+#define CANDIDATE_SET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "config.hpp"
+
+/**
+ * @brief Set of candidate alignment starts of one search word, backed by an epoch-stamped hash table.
+ *
+ * Each worker thread owns one set and reuses it for all of its words. An alignment is reached
+ * through many offsets and filters, so adding probes the table and keeps it once. A slot is
+ * taken only if its stamp is the current epoch, so reset() empties the table by starting a new
+ * epoch. The table grows with the distinct candidates of a word, not with the text.
+ */
+class CandidateSet {
+public:
+    CandidateSet() : slots(INITIAL_CAPACITY) {}
+
+    /**
+     * @brief Empties the set and limits it to alignments below `alignments_limit`.
+     *
+     * @param alignments_limit Alignment starts from this value on are ignored by add()
+     *                         (the word would not fit in the text).
+     */
+    void reset(size_t alignments_limit) {
+        touched.clear();
+        limit = alignments_limit;
+        if (++epoch == 0) {
+            for (Slot& slot : slots) slot.epoch = 0;
+            epoch = 1;
+        }
+    }
+
+    /**
+     * @brief Adds an alignment start, ignoring duplicates and alignments past the limit.
+     */
+    void add(Config::TextPosition alignment) {
+        if (alignment >= limit) return;
+
+        const size_t mask = slots.size() - 1;
+        for (size_t i = slot_of(alignment); ; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.epoch != epoch) {
+                slot = { alignment, epoch };
+                touched.push_back(alignment);
+                if (touched.size() * 2 > slots.size()) grow();
+                return;
+            }
+            if (slot.alignment == alignment) return;
+        }
+    }
+
+    /**
+     * @brief Returns the distinct alignments in text order.
+     */
+    const std::vector<Config::TextPosition>& sorted() {
+        std::sort(touched.begin(), touched.end());
+        return touched;
+    }
+
+private:
+    struct Slot {
+        Config::TextPosition alignment;
+        uint32_t epoch;
+    };
+
+    static constexpr size_t INITIAL_CAPACITY = 1024;    // Power of two, kept at most half full
+
+    /**
+     * @brief Fibonacci hash of an alignment onto a slot index.
+     */
+    size_t slot_of(Config::TextPosition alignment) const {
+        return static_cast<size_t>((static_cast<uint64_t>(alignment) * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1);
+    }
+
+    /**
+     * @brief Doubles the table and re-adds the alignments of the current epoch.
+     */
+    void grow() {
+        slots.assign(slots.size() * 2, Slot{ 0, 0 });
+        epoch = 1;
+        const size_t mask = slots.size() - 1;
+        for (Config::TextPosition alignment : touched) {
+            size_t i = slot_of(alignment);
+            while (slots[i].epoch == epoch) i = (i + 1) & mask;
+            slots[i] = { alignment, epoch };
+        }
+    }
+
+    std::vector<Slot> slots;
+    std::vector<Config::TextPosition> touched;
+    size_t limit = 0;
+    uint32_t epoch = 0;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Maps the given file into memory, closing any previous mapping first.
+ *
+ * @param filename The file to map.
+ * @param access Expected access pattern (read-ahead hint, POSIX only).
+ * @param prefault Flag indicating if all pages should be loaded up front instead of on first touch.
+ * @return int 0 on success, -1 on failure (missing or empty file, mapping error).
+ */
+int MappedFile::open(const std::string& filename, Access access, bool prefault) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return -1;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return -1;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return -1;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return -1;
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+
+    if (prefault) {
+        WIN32_MEMORY_RANGE_ENTRY range = { view, mapped_size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    (void)access;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if (prefault) flags |= MAP_POPULATE;
+#endif
+    void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, flags, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return -1;
+    }
+
+    int advice = access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM;
+    madvise(view, static_cast<size_t>(file_stat.st_size), advice);
+#ifndef MAP_POPULATE
+    if (prefault) madvise(view, static_cast<size_t>(file_stat.st_size), MADV_WILLNEED);
+#endif
+
+    file_descriptor = fd;
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = static_cast<size_t>(file_stat.st_size);
+#endif
+    return 0;
+}
+
+/**
+ * @brief Unmaps the file. Safe to call when nothing is mapped.
+ */
+void MappedFile::close() {
+    if (mapped_data == nullptr) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapped_data);
+    CloseHandle(static_cast<HANDLE>(mapping_handle));
+    CloseHandle(static_cast<HANDLE>(file_handle));
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    munmap(const_cast<char*>(mapped_data), mapped_size);
+    ::close(file_descriptor);
+    file_descriptor = -1;
+#endif
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
@@ -0,0 +1,76 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Read-only memory mapping of a whole file (POSIX mmap / Windows file mapping).
+ *
+ * The mapping stays valid until close() is called or the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief How the mapped pages are going to be read - passed to the kernel as a hint.
+     */
+    enum class Access { RANDOM, SEQUENTIAL };
+
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Maps the given file into memory, closing any previous mapping first.
+     *
+     * @param filename The file to map.
+     * @param access Expected access pattern (read-ahead hint, POSIX only).
+     * @param prefault Flag indicating if all pages should be loaded up front instead of on first touch.
+     * @return int 0 on success, -1 on failure (missing or empty file, mapping error).
+     */
+    int open(const std::string& filename, Access access = Access::RANDOM, bool prefault = false);
+
+    /**
+     * @brief Unmaps the file. Safe to call when nothing is mapped.
+     */
+    void close();
+
+    const char* data() const { return mapped_data; }
+    size_t size() const { return mapped_size; }
+    bool is_open() const { return mapped_data != nullptr; }
+
+private:
+    void swap(MappedFile& other) noexcept {
+        std::swap(mapped_data, other.mapped_data);
+        std::swap(mapped_size, other.mapped_size);
+#ifdef _WIN32
+        std::swap(file_handle, other.file_handle);
+        std::swap(mapping_handle, other.mapping_handle);
+#else
+        std::swap(file_descriptor, other.file_descriptor);
+#endif
+    }
+
+    const char* mapped_data = nullptr;
+    size_t mapped_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
+
+#endif
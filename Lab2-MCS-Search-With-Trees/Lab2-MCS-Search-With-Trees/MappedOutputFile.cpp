@@ -0,0 +1,105 @@
+#include "MappedOutputFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Creates (or truncates) the file with the given size and maps it for writing, closing any previous mapping first.
+ *
+ * @param filename The file to create.
+ * @param size The size of the file in bytes (must be > 0).
+ * @return int 0 on success, -1 on failure (file error, out of disk space, mapping error).
+ */
+int MappedOutputFile::create(const std::string& filename, size_t size) {
+    close();
+    if (size == 0) return -1;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return -1;
+
+    LARGE_INTEGER file_size;
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        CloseHandle(file);
+        return -1;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, file_size.HighPart, file_size.LowPart, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return -1;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return -1;
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+#else
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    // Reserve the blocks up front, so running out of disk space fails here instead of faulting while writing
+    int reserve_status = posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (reserve_status == EINVAL || reserve_status == EOPNOTSUPP)
+        reserve_status = ftruncate(fd, static_cast<off_t>(size));
+    if (reserve_status != 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return -1;
+    }
+    madvise(view, size, MADV_SEQUENTIAL);
+
+    file_descriptor = fd;
+#endif
+    mapped_data = static_cast<char*>(view);
+    mapped_size = size;
+    return 0;
+}
+
+/**
+ * @brief Writes the mapped pages back to the file, then unmaps and closes it. Safe to call when nothing is mapped.
+ *
+ * @return int 0 on success, -1 if writing the mapped pages back failed.
+ */
+int MappedOutputFile::close() {
+    if (mapped_data == nullptr) return 0;
+    int status = 0;
+
+    // Write the mapped pages back before unmapping - unmapping alone does not report a failed write
+#ifdef _WIN32
+    if (!FlushViewOfFile(mapped_data, 0) || !FlushFileBuffers(static_cast<HANDLE>(file_handle))) status = -1;
+    if (!UnmapViewOfFile(mapped_data)) status = -1;
+    CloseHandle(static_cast<HANDLE>(mapping_handle));
+    if (!CloseHandle(static_cast<HANDLE>(file_handle))) status = -1;
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    if (msync(mapped_data, mapped_size, MS_SYNC) != 0) status = -1;
+    if (munmap(mapped_data, mapped_size) != 0) status = -1;
+    if (::close(file_descriptor) != 0) status = -1;
+    file_descriptor = -1;
+#endif
+    mapped_data = nullptr;
+    mapped_size = 0;
+    return status;
+}
@@ -0,0 +1,51 @@
+#ifndef MATCH_ACCUMULATOR_HPP
+#define MATCH_ACCUMULATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "WordMatch.hpp"
+
+/**
+ * @brief Collects (word, position) matches keyed by word id and builds the sorted WordMatch results once.
+ *
+ * Adding a match appends its position to the flat list of the word id, with no lookup or
+ * copy of earlier matches. finish() sorts and deduplicates every list once, spread over
+ * worker threads. Search words with the same text share one id (the index of the first of
+ * them), so they are reported as a single WordMatch, ordered by word.
+ */
+class MatchAccumulator {
+public:
+    explicit MatchAccumulator(const vector<string>& search_words);
+
+    /**
+     * @brief Records a match of the search word at `word_index`. Duplicates are allowed.
+     */
+    void add(size_t word_index, size_t position) {
+        positions[word_ids[word_index]].push_back(static_cast<Config::TextPosition>(position));
+    }
+
+    /**
+     * @brief Records every hit of a buffer and empties it.
+     */
+    void add_hits(vector<WordHit>& hits);
+
+    /**
+     * @brief Sorts and deduplicates the positions of every word and appends the matches to `results` in word order.
+     *
+     * @param threads_count Number of threads to sort on.
+     * @param results The vector to append the matches to.
+     * @return size_t Number of distinct (word, position) matches.
+     */
+    size_t finish(unsigned threads_count, vector<WordMatch>& results);
+
+private:
+    const vector<string>& search_words;
+    vector<uint32_t> word_ids;          // Search word index -> id (index of the first word with the same text)
+    vector<uint32_t> ordered_ids;       // Distinct ids, ordered by word
+    vector<vector<Config::TextPosition>> positions; // Id -> positions, in arrival order until finish()
+};
+
+#endif
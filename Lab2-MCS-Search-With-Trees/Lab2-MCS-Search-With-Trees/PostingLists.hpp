@@ -0,0 +1,76 @@
+#ifndef POSTING_LISTS_HPP
+#define POSTING_LISTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "config.hpp"
+
+/**
+ * @brief Text positions of every tree leaf, stored as one flat array (CSR layout).
+ *
+ * The positions of leaf `l` are positions[offsets[l]] .. positions[offsets[l + 1] - 1],
+ * sorted in ascending order. Offsets are 64-bit, since a large text has several
+ * filtered windows per position.
+ */
+struct PostingLists {
+    std::vector<uint64_t> offsets;
+    std::vector<Config::TextPosition> positions;
+
+    const Config::TextPosition* begin(uint32_t leaf) const {
+        return positions.data() + offsets[leaf];
+    }
+
+    const Config::TextPosition* end(uint32_t leaf) const {
+        return positions.data() + offsets[leaf + 1];
+    }
+
+    /**
+     * @brief Builds the lists from (leaf, position) pairs.
+     *
+     * Pairs of the same leaf keep their relative order, so pairs given in text order
+     * produce sorted lists.
+     *
+     * @param occurrence_leaf Leaf of every pair.
+     * @param occurrence_position Text position of every pair.
+     * @param leaves_count Total number of leaves.
+     */
+    void build(const std::vector<uint32_t>& occurrence_leaf, const std::vector<Config::TextPosition>& occurrence_position, size_t leaves_count) {
+        // Counting sort: count, prefix-sum, then scatter in the given order
+        offsets.assign(leaves_count + 1, 0);
+        for (uint32_t leaf : occurrence_leaf)
+            offsets[leaf + 1]++;
+        for (size_t leaf = 0; leaf < leaves_count; ++leaf)
+            offsets[leaf + 1] += offsets[leaf];
+
+        positions.resize(occurrence_leaf.size());
+        std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t k = 0; k < occurrence_leaf.size(); ++k)
+            positions[cursor[occurrence_leaf[k]]++] = occurrence_position[k];
+    }
+
+    /**
+     * @brief Appends the lists of another set of leaves, numbered after the current ones.
+     *
+     * @param slice Lists built for leaves 0..n of their own, released by the caller after.
+     */
+    void append(const PostingLists& slice) {
+        if (offsets.empty()) offsets.push_back(0);
+        const uint64_t base = positions.size();
+        for (size_t leaf = 1; leaf < slice.offsets.size(); ++leaf)
+            offsets.push_back(base + slice.offsets[leaf]);
+        positions.insert(positions.end(), slice.positions.begin(), slice.positions.end());
+    }
+
+    size_t memory_bytes() const {
+        return offsets.capacity() * sizeof(uint64_t) + positions.capacity() * sizeof(Config::TextPosition);
+    }
+
+    void clear() {
+        std::vector<uint64_t>().swap(offsets);
+        std::vector<Config::TextPosition>().swap(positions);
+    }
+};
+
+#endif
@@ -2,28 +2,33 @@
 #define TREE_ARRAY_ELEMENT_H
 
 #include <cstddef>
+#include <cstdint>
 #include "config.hpp"
-#include "WordMatch.hpp"
-#include <array>
 
 
+/**
+ * @brief Pointers of the array tree elements.
+ *
+ * An element is a row of Alphabet::fanout() pointers, one per symbol code and one for '$'.
+ * Each can point to the next element or to a leaf (when LEAF_FLAG is set).
+ */
 struct TreeArrayElement {
-    //int father;
-    std::array<int, Config::SIZE> pointers{}; // Can point to next element or to word
-    std::array<bool, Config::SIZE> is_leaf{};
+    static constexpr uint32_t EMPTY = UINT32_MAX;       // No child in this slot
+    static constexpr uint32_t LEAF_FLAG = 1u << 31;     // Set when the pointer is a leaf index
 
-    // Default constructor
-    TreeArrayElement() {
-        pointers.fill(-1);
-        is_leaf.fill(false);
+    /**
+     * @brief Checks whether a pointer refers to a leaf rather than to another element.
+     */
+    static bool is_leaf(uint32_t pointer) {
+        return pointer != EMPTY && (pointer & LEAF_FLAG) != 0;
     }
 
-    //// Custom constructor
-    //TreeArrayElement(int parent) : father(parent) {
-    //    pointers.fill(-1);
-    //    is_leaf.fill(false);
-    //}
-
+    /**
+     * @brief Strips the leaf flag, returning the plain element or leaf index.
+     */
+    static uint32_t index_of(uint32_t pointer) {
+        return pointer & ~LEAF_FLAG;
+    }
 };
 
 #endif // TREE_ARRAY_ELEMENT_H
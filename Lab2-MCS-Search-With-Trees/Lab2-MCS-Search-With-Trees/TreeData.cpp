@@ -1,4 +0,0 @@
-#include "TreeData.hpp"
-
-// Definition of the global variable
-TreeData tree_data;
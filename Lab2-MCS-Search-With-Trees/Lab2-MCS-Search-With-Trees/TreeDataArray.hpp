@@ -0,0 +1,79 @@
+#ifndef TREE_DATA_ARRAY_HPP
+#define TREE_DATA_ARRAY_HPP
+
+#include "TreeArrayElement.hpp"
+#include "Arena.hpp"
+#include "PostingLists.hpp"
+#include "MappedFile.hpp"
+#include "Alphabet.hpp"
+#include <vector>
+
+/**
+ * @brief Array-backed MCS tree: elements reference each other by 32-bit indices (nodes[0] is the root).
+ *
+ * Elements are bump-allocated from a single arena, so clearing the tree releases all of
+ * its memory at once. A leaf index addresses the leaf's range in `postings` directly.
+ *
+ * Every element is a row of `alphabet.fanout()` pointers, so the node fanout follows the
+ * alphabet of the text the tree was built from.
+ *
+ * A tree loaded from disk is not copied into the arena - `mapped_file` keeps the tree file
+ * mapped and the `mapped_*` pointers address its sections. Searches go through element(),
+ * leaf_begin() and leaf_end(), which work for both kinds of tree.
+ */
+struct TreeDataArray {
+    Arena arena;
+    Alphabet alphabet;
+    SlabRows<uint32_t> nodes{ arena };
+    uint32_t leaves_count = 0;
+    PostingLists postings;
+
+    MappedFile mapped_file;
+    const uint32_t* mapped_nodes = nullptr;
+    const uint64_t* mapped_offsets = nullptr;
+    const Config::TextPosition* mapped_positions = nullptr;
+    size_t mapped_nodes_count = 0;
+
+    bool is_mapped() const {
+        return mapped_nodes != nullptr;
+    }
+
+    bool empty() const {
+        return nodes.size() == 0 && !is_mapped();
+    }
+
+    size_t nodes_count() const {
+        return is_mapped() ? mapped_nodes_count : nodes.size();
+    }
+
+    const uint32_t* element(uint32_t index) const {
+        return is_mapped() ? mapped_nodes + static_cast<size_t>(index) * alphabet.fanout() : nodes[index];
+    }
+
+    const Config::TextPosition* leaf_begin(uint32_t leaf) const {
+        return is_mapped() ? mapped_positions + mapped_offsets[leaf] : postings.begin(leaf);
+    }
+
+    const Config::TextPosition* leaf_end(uint32_t leaf) const {
+        return is_mapped() ? mapped_positions + mapped_offsets[leaf + 1] : postings.end(leaf);
+    }
+
+    void clear() {
+        alphabet = Alphabet();
+        nodes.clear();
+        leaves_count = 0;
+        postings.clear();
+        arena.release();
+
+        mapped_nodes = nullptr;
+        mapped_offsets = nullptr;
+        mapped_positions = nullptr;
+        mapped_nodes_count = 0;
+        mapped_file.close();
+    }
+};
+
+extern TreeDataArray tree_data_array;
+
+
+#endif
@@ -4,6 +4,9 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <cstdint>
+
+#include "PositionList.hpp"
 
 using std::string;
 using std::vector;
@@ -11,33 +14,23 @@ using std::set;
 
 /**
  * @brief Represents a word and its positions in text.
+ *
+ * The word is stored once, in the search words table, and referenced by its index.
  */
 struct WordMatch {
-    string word;
-    set<size_t> positions;
-
-    bool operator<(const WordMatch& other) const {
-        return word < other.word;
-    }
-
-    /**
-     * @brief Returns a string representation of the WordMatch object.
-     *
-     * @return A string that represents the WordMatch.
-     */
-    string to_string() const {
-        string line = "Word: " + word + "\nPositions: ";
+    uint32_t word_id;
+    PositionList positions;
+};
 
-        // Iterate over the set of positions and concatenate the string
-        size_t count = 0;
-        for (auto pos : positions) {
-            line += std::to_string(pos);
-            if (++count < positions.size()) {
-                line += ", ";
-            }
-        }
+/**
+ * @brief A match found by a worker thread, before it is merged into the WordMatch results.
+ */
+struct WordHit {
+    size_t word_index;
+    size_t position;
 
-        return line;
+    bool operator<(const WordHit& other) const {
+        return word_index != other.word_index ? word_index < other.word_index : position < other.position;
     }
 };
 
@@ -0,0 +1,76 @@
+#include "adaptive_mcs_tree_search.hpp"
+
+using namespace std;
+using namespace Config;
+using namespace Tree_MCS_Search;
+
+namespace Adaptive_Tree_MCS_Search {
+
+    /**
+     * @brief Collects the candidate alignment starts of a word from the adaptive tree.
+     *
+     * Same single-pass explicit-stack walk as the array tree search. A node first consumes
+     * its compressed '$' run (which matches any letter), then branches on both the word
+     * letter and '$'. A word letter outside the tree's alphabet only follows '$'.
+     *
+     * @param word The word to search for in the tree.
+     * @param candidates The set to add the alignment starts to.
+     */
+    static void collect_candidates_from_tree(const string& word, CandidateSet& candidates) {
+        thread_local vector<TraversalFrame> stack;
+        const size_t word_length = word.length();
+        const Alphabet& alphabet = adaptive_tree_data.alphabet;
+        const int dollar_idx = alphabet.mask_code();
+
+        for (size_t offset = 0; offset + FILTER_NUMBER_OF_MATCHES <= word_length; ++offset)
+            stack.push_back({ adaptive_tree_data.root, static_cast<uint16_t>(offset), 0 });
+
+        while (!stack.empty()) {
+            const TraversalFrame frame = stack.back();
+            stack.pop_back();
+
+            const size_t depth = frame.depth + adaptive_tree_data.dollar_prefix(frame.ref);
+            const size_t word_index = frame.offset + depth;
+            if (word_index >= word_length) continue;
+
+            const uint8_t code = alphabet.code(word[word_index]);
+            const uint32_t branches[2] = {
+                code != Alphabet::UNMAPPED ? adaptive_tree_data.find_child(frame.ref, code) : AdaptiveTreeData::EMPTY,
+                adaptive_tree_data.find_child(frame.ref, dollar_idx)
+            };
+
+            for (uint32_t ref : branches) {
+                if (ref == AdaptiveTreeData::EMPTY) continue;
+
+                if (AdaptiveTreeData::is_leaf(ref)) {
+                    uint32_t leaf = AdaptiveTreeData::leaf_index(ref);
+                    append_leaf_candidates(adaptive_tree_data.postings.begin(leaf), adaptive_tree_data.postings.end(leaf), frame.offset, candidates);
+                }
+                else if (word_index + 1 < word_length) {
+                    stack.push_back({ ref, frame.offset, static_cast<uint16_t>(depth + 1) });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Executes the MCS Tree search algorithm over the adaptive-node tree.
+     *
+     * Same flow and results as Tree_MCS_Search::run_tree_mcs_search, with candidate
+     * alignment starts collected from `adaptive_tree_data`.
+     *
+     * @return int Status code indicating success (0) or failure (-1).
+     */
+    int run_adaptive_tree_mcs_search() {
+        cout << "[MCSTreeSearch] Starting adaptive MCS Tree search...\n";
+
+        if (adaptive_tree_data.empty()) {
+            cerr << "[MCSTreeSearch] Failed to load adaptive tree data - it doesnt exist.\n";
+            return -1;
+        }
+
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME);
+        return run_search_with_collector(loader, collect_candidates_from_tree, "Adaptive Tree Search",
+            ADAPTIVE_MCS_TREE_SEARCH_OUTPUT_FILENAME, ADAPTIVE_MCS_TREE_SEARCH_SUMMARY_FILENAME);
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef ADAPTIVE_TREE_MCS_SEARCH_HPP
+#define ADAPTIVE_TREE_MCS_SEARCH_HPP
+
+#include "utils.hpp"
+#include "config.hpp"
+#include "AdaptiveTreeData.hpp"
+#include "create_mcs_tree.hpp"
+#include "mcs_tree_search.hpp"
+
+namespace Adaptive_Tree_MCS_Search {
+	/**
+	 * @brief Executes the MCS Tree search algorithm over the adaptive-node tree.
+	 *
+	 * Same flow and results as Tree_MCS_Search::run_tree_mcs_search, with candidate
+	 * alignment starts collected from `adaptive_tree_data`.
+	 *
+	 * @return int Status code indicating success (0) or failure (-1).
+	 */
+	int run_adaptive_tree_mcs_search();
+}
+
+#endif
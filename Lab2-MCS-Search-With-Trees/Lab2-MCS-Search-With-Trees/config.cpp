@@ -10,9 +10,17 @@ namespace Config {
     void print_config() {
         cout << "================ Program Configuration ================\n";
         cout << "Text size                       : " << TEXT_SIZE << "\n";
+        cout << "Text_Position_Bits              : " << sizeof(TextPosition) * 8 << "\n";
         cout << "Number of Search Words          : " << NUMBER_OF_SEARCH_WORDS << "\n";
         cout << "Number of Variants              : " << NUMBER_OF_VARIATIONS << "\n";
         cout << "Y-Letter                        : " << Y_LETTER << "\n";
+        cout << "Random_Text_Seed                : " << RANDOM_TEXT_SEED << (RANDOM_TEXT_SEED == 0 ? " (new every run)" : "") << "\n";
+        cout << "Text_Generation_Chunk_Size      : " << TEXT_GENERATION_CHUNK_SIZE << "\n";
+        cout << "Alphabet_Filename               : " << ALPHABET_FILENAME << "\n";
+        cout << "Corpus_Filename                 : " << CORPUS_FILENAME << "\n";
+        cout << "Corpus_Fold_Case                : " << (CORPUS_FOLD_CASE ? "yes" : "no") << "\n";
+        cout << "Corpus_Separators (bytes)       : " << CORPUS_SEPARATORS.size() << "\n";
+        cout << "Corpus_Header_Prefix            : " << (CORPUS_HEADER_PREFIX == '\0' ? string("none") : string(1, CORPUS_HEADER_PREFIX)) << "\n";
         cout << "Search_Word_Size (pattern)      : " << SEARCH_WORD_SIZE << "\n";
         cout << "Minimal_Matches (min hits)      : " << MINIMAL_MATCHES << "\n";
         cout << "Filter_Number_Of_Matches        : " << FILTER_NUMBER_OF_MATCHES << "\n";
@@ -21,7 +29,24 @@ namespace Config {
         cout << "Search_Words_Filename           : " << SEARCH_WORDS_FILENAME << "\n";
         cout << "Tree_MCS_Output_Filename        : " << MCS_TREE_SEARCH_OUTPUT_FILENAME << "\n";
         cout << "Tree_MCS_Summary_Filename       : " << MCS_TREE_SEARCH_SUMMARY_FILENAME << "\n";
+        cout << "Tree_MCS_Scaling_Filename       : " << MCS_TREE_SEARCH_SCALING_FILENAME << "\n";
+        cout << "Adaptive_Tree_Output_Filename   : " << ADAPTIVE_MCS_TREE_SEARCH_OUTPUT_FILENAME << "\n";
+        cout << "Adaptive_Tree_Summary_Filename  : " << ADAPTIVE_MCS_TREE_SEARCH_SUMMARY_FILENAME << "\n";
+        cout << "MCS_Tree_Filename               : " << MCS_TREE_FILENAME << "\n";
+        cout << "Offer_MCS_Tree_Save             : " << (OFFER_MCS_TREE_SAVE ? "yes" : "no") << "\n";
+        cout << "Verify_MCS_Tree_File            : " << (VERIFY_MCS_TREE_FILE ? "yes" : "no") << "\n";
+        cout << "Ground_Truth_Filename           : " << GROUND_TRUTH_FILENAME << "\n";
+        cout << "Ground_Truth_Sample_Positions   : " << GROUND_TRUTH_SAMPLE_POSITIONS << "\n";
         cout << "Combined_Summary_Filename       : " << COMBINED_SUMMARY_FILENAME << "\n";
+        cout << "Number_Of_Threads (0 = all)     : " << NUMBER_OF_THREADS << "\n";
+        cout << "Arena_Block_Size (bytes)        : " << ARENA_BLOCK_SIZE << "\n";
+        cout << "Use_Huge_Pages                  : " << (USE_HUGE_PAGES ? "yes" : "no") << "\n";
+        cout << "Prefault_Mapped_Files           : " << (PREFAULT_MAPPED_FILES ? "yes" : "no") << "\n";
+        cout << "Word_Batch_Size                 : " << WORD_BATCH_SIZE << "\n";
+        cout << "Progress_Report_Interval_Ms     : " << PROGRESS_REPORT_INTERVAL_MS << "\n";
+        cout << "Result_Writer_Buffer_Size       : " << RESULT_WRITER_BUFFER_SIZE << "\n";
+        cout << "Save_Results_As_Text            : " << (SAVE_RESULTS_AS_TEXT ? "yes" : "no") << "\n";
+        cout << "Result_Writer_Background        : " << (RESULT_WRITER_BACKGROUND ? "yes" : "no") << "\n";
         cout << "=======================================================\n\n";
     }
 
@@ -31,8 +56,8 @@ namespace Config {
     void validate_config() {
         vector<string> errors;
 
-        const int minimumTextSize = 100000;
-        const int maxSearchWordSizeFactor = 6;
+        const uint64_t minimumTextSize = 100000;
+        const uint64_t maxSearchWordSizeFactor = 6;
 
         if (SEARCH_WORD_SIZE < MINIMAL_MATCHES) {
             errors.emplace_back("MINIMAL_MATCHES should be lower than SEARCH_WORD_SIZE");
@@ -50,7 +75,7 @@ namespace Config {
             errors.emplace_back("Y_LETTER should be a lowercase English letter");
         }
 
-        if ((SEARCH_WORD_SIZE * NUMBER_OF_SEARCH_WORDS) > (TEXT_SIZE * maxSearchWordSizeFactor)) {
+        if (static_cast<uint64_t>(SEARCH_WORD_SIZE) * NUMBER_OF_SEARCH_WORDS > TEXT_SIZE * maxSearchWordSizeFactor) {
             errors.emplace_back("SEARCH_WORD_SIZE * NUMBER_OF_SEARCH_WORDS should not exceed TEXT_SIZE * " + to_string(maxSearchWordSizeFactor));
         }
 
@@ -1,35 +1,72 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <vector>
+#include <type_traits>
 
 namespace Config {
 
-    const int TEXT_SIZE = 1000000; // 1 million characters
+    const uint64_t TEXT_SIZE = 1000000; // 1 million characters
+    typedef std::conditional<(TEXT_SIZE < UINT32_MAX), uint32_t, uint64_t>::type TextPosition; // Text positions are 32-bit while the text fits in them, 64-bit beyond
     const int NUMBER_OF_SEARCH_WORDS = 1000; // Number of search words (taken from the start of the text)
     const int NUMBER_OF_VARIATIONS = 10; // Number of variations of search word inserted into the text
     const int SEARCH_WORD_SIZE = 21; // size of word for search
     const int MINIMAL_MATCHES = 15; // minimal number of matches
     const int FILTER_NUMBER_OF_MATCHES = 6; // number of matches in the filter
     const char Y_LETTER = 'a'; // the start char the text is being generated from (up to z)
-    const size_t SIZE = 'z' - Y_LETTER + 2; // Size of positions array, an extra position for $
+    const uint64_t RANDOM_TEXT_SEED = 0; // Seed of the search words and text (0 for a new seed every run, the used seed is printed)
+    const size_t TEXT_GENERATION_CHUNK_SIZE = 4 * 1024 * 1024; // Characters generated per parallel task (multiple of 4)
+    const std::string ALPHABET_FILENAME = "alphabet.bin"; // Symbols of the current text; tree fanout is their number plus one for $
+    const std::string CORPUS_FILENAME = "corpus.txt"; // Real data read by Corpus Ingestion (FASTA, protein, logs...), encoded into the text file
+    const bool CORPUS_FOLD_CASE = true; // Fold upper-case corpus letters to lower case
+    const std::string CORPUS_SEPARATORS = " \t\r\n"; // Corpus bytes dropped from the text (a newline is always dropped, $ is refused)
+    const char CORPUS_HEADER_PREFIX = '>'; // Corpus lines starting with it are skipped, like FASTA headers ('\0' keeps every line)
 
     const std::string MCS_OUTPUT_FILENAME = "mcs_output"; // Output file for mcs
     const std::string RANDOM_GENERATED_TEXT_FILENAME = "generated_text"; // Output file for random generated text
     const std::string SEARCH_WORDS_FILENAME = "search_words"; // Output file for search words
     const std::string MCS_TREE_SEARCH_OUTPUT_FILENAME = "tree_mcs_search_output"; // Output file for tree MCS search algorithm
     const std::string MCS_TREE_SEARCH_SUMMARY_FILENAME = "summary_tree_mcs"; // Output file for summary of Tree MCS Search
+    const std::string MCS_TREE_SEARCH_SCALING_FILENAME = "scaling_tree_mcs"; // Output file for thread scaling of Tree MCS Search
+    const std::string ADAPTIVE_MCS_TREE_SEARCH_OUTPUT_FILENAME = "adaptive_tree_mcs_search_output"; // Output file for adaptive tree MCS search algorithm
+    const std::string ADAPTIVE_MCS_TREE_SEARCH_SUMMARY_FILENAME = "summary_adaptive_tree_mcs"; // Output file for summary of Adaptive Tree MCS Search
+    const std::string MCS_TREE_FILENAME = "mcs_tree.bin"; // Binary file the MCS tree is saved to and mapped from
+    const bool OFFER_MCS_TREE_SAVE = false; // Ask after building the array MCS tree whether to save it to MCS_TREE_FILENAME (it can take gigabytes)
+    const bool VERIFY_MCS_TREE_FILE = false; // Check every pointer and posting of MCS_TREE_FILENAME when mapping it (reads the whole file)
+    const std::vector<std::string> SEARCH_OUTPUT_FILENAMES = {
+        MCS_TREE_SEARCH_OUTPUT_FILENAME,
+        ADAPTIVE_MCS_TREE_SEARCH_OUTPUT_FILENAME
+    }; // Search results files that can be converted from binary to text
+    const std::string GROUND_TRUTH_FILENAME = "ground_truth.bin"; // Binary manifest of the words planted in the generated text
+    const size_t GROUND_TRUTH_SAMPLE_POSITIONS = 20000; // Text positions naively scanned for incidental matches when validating results
     const std::string COMBINED_SUMMARY_FILENAME = "summary_all"; // Output file for combined summary of all searches
 
-    const int PROGRESS_UPDATES_COUNT = 10000; // Used to control how often progress is updated during a loop
+    const unsigned NUMBER_OF_THREADS = 0; // Worker threads for tree creation and search (0 for all hardware threads)
+    const size_t ARENA_BLOCK_SIZE = 64 * 1024 * 1024; // Size of each memory block the tree arena takes from the system
+    const bool USE_HUGE_PAGES = true; // Ask for transparent huge pages for the tree arena (Linux only)
+
+    const bool PREFAULT_MAPPED_FILES = false; // Load all pages of mapped input files up front instead of on first touch
+    const size_t WORD_BATCH_SIZE = 1024; // Search words parsed per batch; a search starts on the first batch while the rest load
+    const size_t RESULT_WRITER_BUFFER_SIZE = 1024 * 1024; // Size of each buffer results are formatted into before one write call
+    const bool SAVE_RESULTS_AS_TEXT = false; // Also write search results as text (binary .bin results can be converted later from the menu)
+    const bool RESULT_WRITER_BACKGROUND = true; // Write full result buffers on a background thread while the next one is filled
+
+    const int PROGRESS_REPORT_INTERVAL_MS = 200; // How often the background reporter redraws the progress of running loops
     const std::vector<std::string> OPTIONS = {
         "MCS Creation",
         "Random Text and Search Words Creation",
         "MCS Tree Creation",
         "MCS Tree Search",
-        "Create Final Summary"
+        "Create Final Summary",
+        "Adaptive MCS Tree Creation",
+        "Adaptive MCS Tree Search",
+        "MCS Tree Search Scaling",
+        "Convert Results To Text",
+        "Validate Results Against Ground Truth",
+        "Corpus Ingestion"
     }; // List of choices for user
 
     /**
@@ -0,0 +1,54 @@
+#ifndef CORPUS_INGESTION_HPP
+#define CORPUS_INGESTION_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include "config.hpp"
+#include "utils.hpp"
+#include "dataset_cache.hpp"
+#include "Alphabet.hpp"
+
+namespace CorpusIngestion {
+
+    /**
+     * @brief Counts of one corpus ingestion.
+     */
+    struct IngestionStats {
+        uint64_t corpus_bytes = 0;      // Bytes read from the corpus
+        uint64_t header_lines = 0;      // Lines skipped for starting with CORPUS_HEADER_PREFIX
+        uint64_t dropped_bytes = 0;     // Separators, header bytes and '$' left out of the text
+        uint64_t folded_bytes = 0;      // Upper-case letters folded to lower case
+        uint64_t text_size = 0;         // Symbols written to the text
+        bool truncated = false;         // The corpus had more than TEXT_SIZE symbols
+    };
+
+    /**
+     * @brief Encodes a corpus into the text file and saves the alphabet of the text.
+     *
+     * Header lines and separators are dropped and letters are case-folded (see the CORPUS_*
+     * config), leaving one byte per symbol with no line structure. The symbols found get the
+     * dense codes of the alphabet, saved to ALPHABET_FILENAME, which the trees and packed keys
+     * size themselves by. The text stops at TEXT_SIZE symbols, so its positions fit TextPosition.
+     * A corpus holding Alphabet::MASK outside header lines and separators is refused.
+     *
+     * @param corpus_filename The corpus to read.
+     * @param alphabet Set to the alphabet of the text.
+     * @param stats Set to the counts of the ingestion.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled.
+     */
+    int ingest_corpus(const std::string& corpus_filename, Alphabet& alphabet, IngestionStats& stats);
+
+    /**
+     * @brief Ingests CORPUS_FILENAME into the text file and samples the search words from it.
+     *
+     * The NUMBER_OF_SEARCH_WORDS search words are windows of the encoded text at random
+     * positions, the same for a given RANDOM_TEXT_SEED. Nothing is planted, so the corpus
+     * has no ground truth manifest.
+     *
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled.
+     */
+    int run_corpus_ingestion();
+}
+
+#endif
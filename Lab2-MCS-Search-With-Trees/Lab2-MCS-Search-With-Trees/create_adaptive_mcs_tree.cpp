@@ -0,0 +1,87 @@
+#include "create_adaptive_mcs_tree.hpp"
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+using namespace Create_MCS_Tree;
+
+namespace Create_Adaptive_MCS_Tree {
+
+    /**
+     * @brief Constructs the adaptive-node MCS tree from input files.
+     *
+     * Same input and keys as Create_MCS_Tree::create_mcs_tree, but the keys are stored
+     * in small adaptive nodes with '$' runs compressed into the nodes.
+     *
+     * @return 0 on success, -1 on failure (e.g., file loading error).
+     */
+    int create_adaptive_mcs_tree() {
+        // === Phase 1: Read files ===
+        MappedText mapped_text;
+        if (map_text_from_file(RANDOM_GENERATED_TEXT_FILENAME, mapped_text) != 0) {
+            cerr << "[AdaptiveMCSTreeBuilder] Failed to load text.\n";
+            return -1;
+        }
+        string_view text = without_line_break(mapped_text.text);
+
+        vector<string> filters = read_lines_from_file(MCS_OUTPUT_FILENAME);
+        if (filters.empty()) {
+            cerr << "[AdaptiveMCSTreeBuilder] Failed to load MCS filters.\n";
+            return -1;
+        }
+
+        Alphabet alphabet;
+        if (Alphabet::load_current(alphabet) != 0) return -1;
+        if (!alphabet.encodes(text)) {
+            cerr << "[AdaptiveMCSTreeBuilder] Text has characters outside its alphabet (" << alphabet.printable() << ") - create the text again.\n";
+            return -1;
+        }
+
+        // Init
+        adaptive_tree_data.reset(alphabet);
+        size_t text_len = text.length();
+        // Every filter is keyed up to the end of the text, so the last search window is found at any word offset
+        size_t shortest_filter = filters[0].size();
+        for (const string& filter : filters) shortest_filter = min(shortest_filter, filter.size());
+        size_t total_iterations = text_len - shortest_filter + 1;
+        vector<uint32_t> occurrence_leaf; // Leaf hit by every (window, filter) pair, in text order
+        vector<TextPosition> occurrence_position;
+        occurrence_leaf.reserve(total_iterations * filters.size());
+        occurrence_position.reserve(total_iterations * filters.size());
+
+        // === Phase 2: Iterate through text ===
+        Telemetry::ProgressCounter progress("Adaptive tree", total_iterations);
+        for (size_t i = 0; i < total_iterations; ++i) {
+
+            // === Phase 3: Insert every filtered window ===
+            for (const string& filter : filters) {
+                if (i + filter.size() > text_len) continue;
+                string filtered = apply_filter_to_word(text.substr(i, filter.size()), filter);
+
+                uint32_t leaf = adaptive_tree_data.insert(filtered);
+                if (leaf == AdaptiveTreeData::EMPTY) {
+                    cerr << "[AdaptiveMCSTreeBuilder] Tree exceeded the maximal number of nodes.\n";
+                    adaptive_tree_data.clear();
+                    return -1;
+                }
+                occurrence_leaf.push_back(leaf);
+                occurrence_position.push_back(static_cast<TextPosition>(i));
+            }
+
+            progress.set(i + 1);
+        }
+        progress.finish();
+
+        // === Phase 4: Attach the text positions to the leaves ===
+        adaptive_tree_data.postings.build(occurrence_leaf, occurrence_position, adaptive_tree_data.leaves_count);
+
+        cout << "[AdaptiveMCSTreeBuilder] Tree has " << adaptive_tree_data.nodes4.size() << " nodes of 4, "
+             << adaptive_tree_data.nodes16.size() << " nodes of 16, " << adaptive_tree_data.nodes_full.size()
+             << " full nodes of " << alphabet.fanout() << " and " << adaptive_tree_data.leaves_count << " leaves.\n";
+        cout << "[AdaptiveMCSTreeBuilder] Tree memory: " << adaptive_tree_data.arena.bytes_used() / (1024 * 1024) << " MB used, "
+             << adaptive_tree_data.arena.bytes_reserved() / (1024 * 1024) << " MB reserved, "
+             << adaptive_tree_data.postings.memory_bytes() / (1024 * 1024) << " MB of postings.\n";
+        cout << "[AdaptiveMCSTreeBuilder] Adaptive MCS tree creation complete.\n";
+        return 0;
+    }
+}
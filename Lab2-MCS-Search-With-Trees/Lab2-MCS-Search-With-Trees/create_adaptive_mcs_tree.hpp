@@ -0,0 +1,22 @@
+#ifndef CREATE_ADAPTIVE_MCS_TREE_HPP
+#define CREATE_ADAPTIVE_MCS_TREE_HPP
+
+#include "utils.hpp"
+#include "config.hpp"
+#include "AdaptiveTreeData.hpp"
+#include "create_mcs_tree.hpp"
+
+namespace Create_Adaptive_MCS_Tree {
+
+    /**
+     * @brief Constructs the adaptive-node MCS tree from input files.
+     *
+     * Same input and keys as Create_MCS_Tree::create_mcs_tree, but the keys are stored
+     * in small adaptive nodes with '$' runs compressed into the nodes.
+     *
+     * @return 0 on success, -1 on failure (e.g., file loading error).
+     */
+    int create_adaptive_mcs_tree();
+}
+
+#endif
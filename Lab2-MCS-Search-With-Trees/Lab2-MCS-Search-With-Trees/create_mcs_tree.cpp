@@ -18,7 +18,7 @@ namespace Create_MCS_Tree {
      *
      * @return A filtered string where the characters are either from the `word` or '$' depending on the filter.
      */
-    static string apply_filter_to_word(const string& word, const string& filter) {
+    string apply_filter_to_word(string_view word, const string& filter) {
         string filtered_word(word.size(), '$');
 
         for (size_t i = 0; i < filter.size(); ++i)
@@ -28,15 +28,118 @@ namespace Create_MCS_Tree {
         return filtered_word;
     }
 
+    // The windows are split into this many text ranges, whatever the number of threads, so the tree is always the same
+    static const size_t BUILD_RANGES_COUNT = 64;
+    // Key prefixes are made long enough to give at least this many buckets, so the threads are not capped by the alphabet size
+    static const size_t MIN_BUILD_BUCKETS = 256;
+
+    /**
+     * @brief One filter applied at one text position - a key to insert into the tree.
+     */
+    struct WindowKey {
+        TextPosition position;
+        uint32_t filter;
+    };
+
+    /**
+     * @brief Private part of the tree holding every key that starts with one prefix.
+     *
+     * Subtrees of different prefixes share nothing, so they are built in parallel
+     * and later linked under the elements of their prefix. Each one sorts its own
+     * text positions into posting lists, which are appended to the tree's lists as is.
+     */
+    struct SubTree {
+        vector<uint32_t> nodes;         // Rows of alphabet.fanout() pointers, the first row is the element after the prefix
+        uint32_t leaves_count = 0;
+        PostingLists postings;          // Lists of the local leaves 0..leaves_count - 1
+    };
+
     /**
-     * @brief Maps a character to an index in the pointer array.
-     * @param letter The input character, where '$' is treated specially.
-     * @return Integer index corresponding to the character.
+     * @brief Pointer index of character `j` of the key of `filter` at text position `position`.
      */
-    int index_fixer(char letter) {
-        if (letter == '$')
-            return SIZE - 1;
-        return letter - Y_LETTER;
+    static int key_index(string_view text, const Alphabet& alphabet, const string& filter, size_t position, size_t j) {
+        return filter[j] == '1' ? alphabet.code(text[position + j]) : alphabet.mask_code();
+    }
+
+    /**
+     * @brief Sorts the keys of the windows [begin, end) into buckets by their first `prefix_length` characters.
+     *
+     * Keys keep their text order within a bucket. A filter only gets keys at the windows it fits in.
+     *
+     * @param text The text to index.
+     * @param filters The MCS filters.
+     * @param alphabet The alphabet of the text.
+     * @param prefix_length Number of key characters that pick the bucket.
+     * @param begin First window of the range.
+     * @param end Window after the last one of the range.
+     * @param buckets The buckets to fill, indexed by the prefix read as a number in base alphabet.fanout().
+     */
+    static void bucket_range(string_view text, const vector<string>& filters, const Alphabet& alphabet, size_t prefix_length,
+                             size_t begin, size_t end, vector<vector<WindowKey>>& buckets) {
+        const size_t fanout = alphabet.fanout();
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t f = 0; f < filters.size(); ++f) {
+                if (i + filters[f].size() > text.size()) continue;
+
+                size_t bucket = 0;
+                for (size_t j = 0; j < prefix_length; ++j)
+                    bucket = bucket * fanout + key_index(text, alphabet, filters[f], i, j);
+                buckets[bucket].push_back({ static_cast<TextPosition>(i), static_cast<uint32_t>(f) });
+            }
+        }
+    }
+
+    /**
+     * @brief Builds the subtree of one bucket from its keys in every text range, in range order.
+     *
+     * The (leaf, position) pairs of the keys are sorted into the subtree's posting lists
+     * as soon as the bucket is done, so only one bucket's pairs exist at a time per thread.
+     *
+     * @param text The text to index.
+     * @param filters The MCS filters.
+     * @param alphabet The alphabet of the text.
+     * @param prefix_length Number of key characters the bucket is picked by.
+     * @param range_buckets The buckets of every text range. The keys of this bucket are released.
+     * @param bucket The index of the bucket.
+     * @param subtree The subtree to fill.
+     */
+    static void build_subtree(string_view text, const vector<string>& filters, const Alphabet& alphabet, size_t prefix_length,
+                              vector<vector<vector<WindowKey>>>& range_buckets, size_t bucket, SubTree& subtree) {
+        const size_t fanout = alphabet.fanout();
+        subtree.nodes.assign(fanout, TreeArrayElement::EMPTY);
+        vector<uint32_t> occurrence_leaf;
+        vector<TextPosition> occurrence_position;
+
+        for (vector<vector<WindowKey>>& buckets : range_buckets) {
+            for (const WindowKey& key : buckets[bucket]) {
+                const string& filter = filters[key.filter];
+
+                // Walk / create the rest of the key, masking characters on the fly
+                size_t current = 0;
+                for (size_t j = prefix_length; j < filter.size(); ++j) {
+                    int idx = key_index(text, alphabet, filter, key.position, j);
+                    uint32_t& pointer = subtree.nodes[current * fanout + idx];
+
+                    if (j != filter.size() - 1) {
+                        if (pointer == TreeArrayElement::EMPTY) {
+                            pointer = static_cast<uint32_t>(subtree.nodes.size() / fanout);
+                            subtree.nodes.insert(subtree.nodes.end(), fanout, TreeArrayElement::EMPTY); // Invalidates `pointer`
+                        }
+                        current = subtree.nodes[current * fanout + idx];
+                    }
+                    else {
+                        // Last character - store a leaf index instead of creating a new element
+                        if (pointer == TreeArrayElement::EMPTY)
+                            pointer = TreeArrayElement::LEAF_FLAG | subtree.leaves_count++;
+                        occurrence_leaf.push_back(TreeArrayElement::index_of(pointer));
+                        occurrence_position.push_back(key.position);
+                    }
+                }
+            }
+            vector<WindowKey>().swap(buckets[bucket]);
+        }
+
+        subtree.postings.build(occurrence_leaf, occurrence_position, subtree.leaves_count);
     }
 
     /**
@@ -44,16 +147,26 @@ namespace Create_MCS_Tree {
      *
      * Reads a random text file and a set of MCS filters, then builds a tree
      * by sliding a window over the text and inserting filtered characters.
+     * Text ranges are scanned in parallel, sorting the keys of every window into
+     * buckets by their first characters, and then the subtree of every bucket is built
+     * in parallel, so each key is inserted once. Keys keep their text order within a
+     * bucket and the subtrees are linked in prefix order, so the result does not
+     * depend on the number of threads. Every subtree brings its own posting lists,
+     * which are appended to the tree's lists and released as the subtree is linked. Elements have one pointer per
+     * symbol of the text's alphabet (Alphabet::load_current) and one for '$'. With
+     * Config::OFFER_MCS_TREE_SAVE the user is asked whether to save the finished tree to
+     * Config::MCS_TREE_FILENAME, so later runs can map it instead of rebuilding.
      *
      * @return 0 on success, -1 on failure (e.g., file loading error).
      */
     int create_mcs_tree() {
         // === Phase 1: Read files ===
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        MappedText mapped_text;
+        if (map_text_from_file(RANDOM_GENERATED_TEXT_FILENAME, mapped_text) != 0) {
             cerr << "[MCSTreeBuilder] Failed to load text.\n";
             return -1;
         }
+        string_view text = without_line_break(mapped_text.text);
 
         vector<string> filters = read_lines_from_file(MCS_OUTPUT_FILENAME);
         if (filters.empty()) {
@@ -61,49 +174,132 @@ namespace Create_MCS_Tree {
             return -1;
         }
 
+        Alphabet alphabet;
+        if (Alphabet::load_current(alphabet) != 0) return -1;
+        if (!alphabet.encodes(text)) {
+            cerr << "[MCSTreeBuilder] Text has characters outside its alphabet (" << alphabet.printable() << ") - create the text again.\n";
+            return -1;
+        }
+
         // Init
-        tree_data.tree = new TreeNode();
-        size_t text_len = text.length();
-        size_t total_iterations = text_len - SEARCH_WORD_SIZE + 1;
-
-        // === Phase 2: Iterate through text ===
-        for (size_t i = 0; i < total_iterations; ++i) {
-
-            // === Phase 3: Iterate through filters ===
-            for (const string& filter : filters) {
-                string word = text.substr(i, filter.size());
-
-                string filtered = apply_filter_to_word(word, filter);
-                tree_data.filters_map[filtered].insert(i);
-
-                // === Phase 4: Create Tree Nodes
-                TreeNode* current = tree_data.tree;
-                for (size_t j = 0; j < filtered.size(); ++j) {
-                    char ch = filtered[j];
-                    int idx = index_fixer(ch);
-
-                    if (j != filtered.size() - 1) {
-                        if (current->pointers[idx] == nullptr) {
-                            TreeNode* new_node = new TreeNode(current);
-                            current->pointers[idx] = static_cast<void*>(new_node);
-                        }
-                        current = static_cast<TreeNode*>(current->pointers[idx]);
-                    }
-                    else {
-                        // Last character  store filtered word instead of creating a new node
-                        if (current->pointers[idx] == nullptr) {
-                            current->pointers[idx] = static_cast<void*>(new string(filtered));
-                            current->is_leaf[idx] = true;
-                        }
-                    }
+        tree_data_array.clear();
+        tree_data_array.alphabet = alphabet;
+        const size_t fanout = alphabet.fanout();
+        unsigned threads_count = get_number_of_threads();
+
+        // The prefix stops before the last character of the shortest key, so every leaf is inside a subtree
+        size_t shortest_filter = filters[0].size();
+        for (const string& filter : filters) shortest_filter = min(shortest_filter, filter.size());
+        size_t prefix_length = 0;
+        size_t buckets_count = 1;
+        while (buckets_count < MIN_BUILD_BUCKETS && prefix_length + 1 < shortest_filter) {
+            prefix_length++;
+            buckets_count *= fanout;
+        }
+
+        // A word matching the last search window is found through its filters at any word offset, so every
+        // filter is keyed up to the end of the text, not only at the first characters of full windows
+        const size_t windows_count = text.length() - shortest_filter + 1;
+        const size_t ranges_count = min(BUILD_RANGES_COUNT, windows_count);
+        vector<vector<vector<WindowKey>>> range_buckets(ranges_count, vector<vector<WindowKey>>(buckets_count));
+        vector<SubTree> subtrees(buckets_count);
+
+        // === Phase 2: Sort the keys of every text range into buckets, in parallel ===
+        cout << "[MCSTreeBuilder] Sorting keys of " << ranges_count << " text ranges into " << buckets_count
+             << " buckets (" << prefix_length << "-character prefixes) on " << threads_count << " threads...\n";
+        WorkStealingScheduler scheduler(threads_count);
+        scheduler.run(ranges_count, [&](unsigned, size_t range) {
+            bucket_range(text, filters, alphabet, prefix_length,
+                         windows_count * range / ranges_count, windows_count * (range + 1) / ranges_count, range_buckets[range]);
+        });
+
+        // === Phase 3: Build the subtree of every bucket, in parallel ===
+        cout << "[MCSTreeBuilder] Building the subtrees...\n";
+        scheduler.run(buckets_count, [&](unsigned, size_t bucket) {
+            build_subtree(text, filters, alphabet, prefix_length, range_buckets, bucket, subtrees[bucket]);
+        }, true);
+        vector<vector<vector<WindowKey>>>().swap(range_buckets);
+        scheduler.print_stats("[MCSTreeBuilder]");
 
+        // === Phase 4: Link the subtrees and their posting lists under the elements of their prefixes ===
+        SlabRows<uint32_t>& nodes = tree_data_array.nodes;
+        nodes.reset(fanout);
+        if (prefix_length > 0) nodes.push_back(TreeArrayElement::EMPTY); // Root element
+        vector<size_t> prefix(prefix_length);
+
+        PostingLists& postings = tree_data_array.postings;
+        size_t total_leaves = 0;
+        size_t total_positions = 0;
+        for (const SubTree& subtree : subtrees) {
+            total_leaves += subtree.leaves_count;
+            total_positions += subtree.postings.positions.size();
+        }
+        postings.offsets.reserve(total_leaves + 1);
+        postings.offsets.assign(1, 0);
+        postings.positions.reserve(total_positions);
+
+        for (size_t bucket = 0; bucket < buckets_count; ++bucket) {
+            SubTree& subtree = subtrees[bucket];
+            if (subtree.postings.positions.empty()) continue;
+
+            // Walk / create the elements of the prefix, the last one points to the subtree root
+            for (size_t j = prefix_length, rest = bucket; j > 0; --j, rest /= fanout)
+                prefix[j - 1] = rest % fanout;
+            size_t current = 0;
+            for (size_t j = 0; j + 1 < prefix_length; ++j) {
+                if (nodes[current][prefix[j]] == TreeArrayElement::EMPTY) {
+                    uint32_t element = nodes.push_back(TreeArrayElement::EMPTY);
+                    nodes[current][prefix[j]] = element;
                 }
+                current = nodes[current][prefix[j]];
             }
 
-            print_progress(static_cast<int>(i + 1), static_cast<int>(total_iterations));
+            size_t node_base = nodes.size();
+            size_t leaf_base = tree_data_array.leaves_count;
+            if (node_base + subtree.nodes.size() / fanout >= TreeArrayElement::LEAF_FLAG ||
+                leaf_base + subtree.leaves_count >= TreeArrayElement::LEAF_FLAG) {
+                cerr << "[MCSTreeBuilder] Tree exceeded the maximal number of elements.\n";
+                tree_data_array.clear();
+                return -1;
+            }
+            if (prefix_length > 0) nodes[current][prefix[prefix_length - 1]] = static_cast<uint32_t>(node_base);
+
+            // Shift element and leaf indices by the bases of this subtree
+            for (size_t row = 0; row < subtree.nodes.size(); row += fanout) {
+                uint32_t* element = nodes[nodes.push_back(TreeArrayElement::EMPTY)];
+                for (size_t i = 0; i < fanout; ++i) {
+                    uint32_t pointer = subtree.nodes[row + i];
+                    if (pointer == TreeArrayElement::EMPTY) continue;
+                    element[i] = TreeArrayElement::is_leaf(pointer)
+                        ? TreeArrayElement::LEAF_FLAG | static_cast<uint32_t>(TreeArrayElement::index_of(pointer) + leaf_base)
+                        : static_cast<uint32_t>(pointer + node_base);
+                }
+            }
+
+            tree_data_array.leaves_count += subtree.leaves_count;
+            postings.append(subtree.postings);
+
+            subtree = SubTree(); // Release the linked subtree
+        }
+
+        cout << "[MCSTreeBuilder] Tree has " << nodes.size() << " elements and " << tree_data_array.leaves_count << " leaves.\n";
+        cout << "[MCSTreeBuilder] Tree memory: " << tree_data_array.arena.bytes_used() / (1024 * 1024) << " MB used, "
+             << tree_data_array.arena.bytes_reserved() / (1024 * 1024) << " MB reserved, "
+             << tree_data_array.postings.memory_bytes() / (1024 * 1024) << " MB of postings.\n";
+
+        // === Phase 5: Offer to save the tree for later runs ===
+        if (OFFER_MCS_TREE_SAVE) {
+            cout << "[MCSTreeBuilder] Save the tree to " << MCS_TREE_FILENAME << " ("
+                 << MCS_Tree_File::saved_file_size() / (1024 * 1024) << " MB) for later runs? (y/n)\n";
+            char choice = 'n';
+            cin >> choice;
+            if (choice == 'y' || choice == 'Y') {
+                if (MCS_Tree_File::save_mcs_tree(text, filters) != 0)
+                    cerr << "[MCSTreeBuilder] Tree was not saved - it is only available in this run.\n";
+            }
         }
 
         cout << "[MCSTreeBuilder] MCS tree creation complete.\n";
         return 0;
-    }  
-}
\ No newline at end of file
+    }
+}
@@ -3,24 +3,35 @@
 
 #include "utils.hpp"
 #include "config.hpp"
-#include "TreeNode.hpp"
-#include "TreeData.hpp"
+#include "TreeArrayElement.hpp"
+#include "TreeDataArray.hpp"
+#include "Alphabet.hpp"
+#include "mcs_tree_file.hpp"
+#include "WorkStealingScheduler.hpp"
 #include <queue>
 
 namespace Create_MCS_Tree {
 
     /**
-     * @brief Maps a character to an index in the pointer array.
-     * @param letter The input character, where '$' is treated specially.
-     * @return Integer index corresponding to the character.
+     * @brief Applies a binary filter to a given word and returns a filtered version of the word.
+     *
+     * @param word The word to be filtered.
+     * @param filter A string of '0's and '1's - '1' keeps the character, '0' replaces it with '$'.
+     * @return A filtered string where the characters are either from the `word` or '$' depending on the filter.
      */
-    int index_fixer(char letter);
+    string apply_filter_to_word(std::string_view word, const string& filter);
 
     /**
      * @brief Constructs a multi-filter character sequence tree from input files.
      *
      * Reads a random text file and a set of MCS filters, then builds a tree
      * by sliding a window over the text and inserting filtered characters.
+     * Keys are sorted into buckets by prefix over text ranges in parallel, and the
+     * subtrees of the buckets are built in parallel on get_number_of_threads()
+     * threads and linked in prefix order. The element
+     * fanout is the size of the text's alphabet plus one for '$'.
+     * With Config::OFFER_MCS_TREE_SAVE the user is asked whether to save the finished
+     * tree to Config::MCS_TREE_FILENAME for later runs.
      *
      * @return 0 on success, -1 on failure (e.g., file loading error).
      */
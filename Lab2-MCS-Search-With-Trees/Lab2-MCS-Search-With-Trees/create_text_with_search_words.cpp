@@ -6,10 +6,42 @@ using namespace Utils;
 
 namespace SearchWordsAndTextGenerator {
 
-    static random_device rd;
-    static mt19937 gen(rd());
+    static mt19937_64 gen;
     uniform_int_distribution<> char_dist(Y_LETTER, 'z');
 
+    static const uint64_t CHARS_PER_DRAW = 4; // Characters taken from every 64-bit random draw of the text fill
+    static_assert(TEXT_GENERATION_CHUNK_SIZE % CHARS_PER_DRAW == 0, "TEXT_GENERATION_CHUNK_SIZE must be a multiple of 4");
+
+    /**
+     * @brief SplitMix64 output function - maps a counter value to 64 well-mixed random bits.
+     */
+    static uint64_t split_mix64(uint64_t counter) {
+        uint64_t z = counter;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Writes the random letters of text positions [first, first + count) to `out`.
+     *
+     * Every group of CHARS_PER_DRAW positions takes its letters from one SplitMix64 draw of its
+     * own index, so the chunks can be filled on any thread and the text depends only on the seed.
+     * `first` must be a multiple of CHARS_PER_DRAW.
+     */
+    static void fill_random_chars(char* out, uint64_t first, uint64_t count, uint64_t seed) {
+        const uint32_t letters_count = 'z' - Y_LETTER + 1;
+        uint64_t written = 0;
+
+        for (uint64_t draw = first / CHARS_PER_DRAW; written < count; ++draw) {
+            uint64_t bits = split_mix64(seed + (draw + 1) * 0x9E3779B97F4A7C15ULL);
+
+            // 16 bits per letter, scaled into the letter range
+            for (uint64_t lane = 0; lane < CHARS_PER_DRAW && written < count; ++lane, bits >>= 16)
+                out[written++] = static_cast<char>(Y_LETTER + (((bits & 0xFFFF) * letters_count) >> 16));
+        }
+    }
+
     /**
      * @brief Generates a list of search words from the random text file
      *        and saves it to a file.
@@ -26,6 +58,7 @@ namespace SearchWordsAndTextGenerator {
         cout << "[TextAndSearchWordsGenerator] Generating " << NUMBER_OF_SEARCH_WORDS << " Search Words...\n";
         // Init
         vector<string> search_words;
+        Telemetry::ProgressCounter progress("Search words", NUMBER_OF_SEARCH_WORDS);
 
         // Create all search words
         while (search_words.size() < NUMBER_OF_SEARCH_WORDS) {
@@ -33,8 +66,9 @@ namespace SearchWordsAndTextGenerator {
             for (int i = 0; i < SEARCH_WORD_SIZE; i++)
                 curr_search_word += static_cast<char>(char_dist(gen));
             search_words.push_back(curr_search_word);
-            print_progress(static_cast<int>(search_words.size()), NUMBER_OF_SEARCH_WORDS);
+            progress.set(search_words.size());
         }
+        progress.finish();
 
         // Save the vector to a file
         int status = save_to_file(search_words, SEARCH_WORDS_FILENAME);
@@ -79,13 +113,18 @@ namespace SearchWordsAndTextGenerator {
      * @brief Generates random text by inserting search words and their variants at random positions.
      *
      * This function generates a random text of size `TEXT_SIZE` by inserting a list of search words
-     * and their variants. Each word and its variants are inserted at random positions in the text,
-     * and no positions are overwritten. After all words have been inserted, the remaining empty
-     * positions are filled with random characters.
+     * and their variants. The whole text is first filled with random letters in parallel, straight
+     * into a memory-mapped output file. The text is then seen as a random sequence of word slots
+     * and single letters: one pass of selection sampling picks which units are word slots, and
+     * the words and variants, in shuffled order, are copied into them. No words overlap, and the
+     * time is linear in the text size however densely the words cover it. The planted positions
+     * are saved to the ground truth manifest, for validating search results, and the letters
+     * are saved as the alphabet of the text.
      *
+     * @param seed The seed of the random letters.
      * @return int 0 on success, non-zero value on failure.
      */
-    static int generate_text() {
+    static int generate_text(uint64_t seed) {
         cout << "[TextAndSearchWordsGenerator] Generating random text of size " << TEXT_SIZE << "...\n";
 
         // === Load search words ===
@@ -95,54 +134,80 @@ namespace SearchWordsAndTextGenerator {
             return -1;
         }
 
-        // Init
-        string text(TEXT_SIZE, ' ');
-        unordered_set<size_t> taken_positions; // Used to track taken positions
-        uniform_int_distribution<> num_dist_index(0, TEXT_SIZE - SEARCH_WORD_SIZE);
-        int total_inserted = 0;
-        
-        cout << "[TextAndSearchWordsGenerator] Starting building text with search words and its variants..\n";
-        for (const string& word : search_words) {
-            vector<string> variants = get_word_variants(word);
-            variants.push_back(word); // Add original word as well
-
-            for (const string& variant : variants) {
-                bool inserted = false;
-
-                while (!inserted) {
-                    // Generate a random starting index for the word/variant
-                    size_t random_index = num_dist_index(gen);
-
-                    // Check if the first and last position are available
-                    if (taken_positions.find(random_index) == taken_positions.end() &&
-                        taken_positions.find(random_index + SEARCH_WORD_SIZE - 1) == taken_positions.end()) {
-
-                        // Insert the word/variant into the text at the random position
-                        for (size_t i = 0; i < SEARCH_WORD_SIZE; i++) {
-                            text[random_index + i] = variant[i];
-                            taken_positions.insert(random_index + i);  // Mark position as taken
-                        }
-                        inserted = true;  // Successfully inserted the variant
-                    }
-                }
-
-                total_inserted++;
-                print_progress(total_inserted, NUMBER_OF_SEARCH_WORDS * (NUMBER_OF_VARIATIONS + 1));
+        // === Create every word and its variants, and the order they are placed in ===
+        vector<string> planted_words;
+        vector<GroundTruth::PlantedWord> planted_info; // Word id and mismatches of each planted word, positions set when placed
+        planted_words.reserve(search_words.size() * (NUMBER_OF_VARIATIONS + 1));
+        planted_info.reserve(search_words.size() * (NUMBER_OF_VARIATIONS + 1));
+        for (size_t word_id = 0; word_id < search_words.size(); word_id++) {
+            const string& word = search_words[word_id];
+            for (string& variant : get_word_variants(word)) {
+                planted_info.push_back({ 0, static_cast<uint32_t>(word_id), GroundTruth::count_mismatches(variant.data(), word) });
+                planted_words.push_back(move(variant));
             }
+            planted_info.push_back({ 0, static_cast<uint32_t>(word_id), 0 });
+            planted_words.push_back(word); // Add original word as well
         }
-
-        // Fill the remaining empty spaces with random characters
-        cout << "[TextAndSearchWordsGenerator] Filling missing spaces with random letters..\n";
-        for (int i = 0; i < TEXT_SIZE; i++) {
-            if (taken_positions.find(i) == taken_positions.end()) {
-                text[i] = static_cast<char>(char_dist(gen));
+        vector<uint32_t> placement_order(planted_words.size());
+        for (size_t i = 0; i < placement_order.size(); i++) placement_order[i] = static_cast<uint32_t>(i);
+        shuffle(placement_order.begin(), placement_order.end(), gen);
+
+        // === Map the output file, the text followed by a newline like save_to_file writes it ===
+        const size_t text_size = static_cast<size_t>(TEXT_SIZE);
+        MappedOutputFile output;
+        int status = create_mapped_output(output, RANDOM_GENERATED_TEXT_FILENAME, text_size + 1);
+        if (status != 0) return status;
+        char* text = output.data();
+
+        // === Fill the whole text with random letters, in parallel chunks ===
+        cout << "[TextAndSearchWordsGenerator] Filling the text with random letters..\n";
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        size_t chunks_count = (text_size + TEXT_GENERATION_CHUNK_SIZE - 1) / TEXT_GENERATION_CHUNK_SIZE;
+        Telemetry::ProgressCounter fill_progress("Text", text_size);
+        scheduler.run(chunks_count, [&](unsigned, size_t chunk) {
+            size_t first = chunk * TEXT_GENERATION_CHUNK_SIZE;
+            size_t count = min(TEXT_GENERATION_CHUNK_SIZE, text_size - first);
+            fill_random_chars(text + first, first, count, seed);
+            fill_progress.add(count);
+        });
+        text[text_size] = '\n';
+        fill_progress.finish();
+
+        // === Place the words: each remaining unit is a word slot with probability remaining words / remaining units ===
+        cout << "[TextAndSearchWordsGenerator] Starting building text with search words and its variants..\n";
+        size_t remaining_words = planted_words.size();
+        size_t remaining_units = remaining_words + (text_size - remaining_words * SEARCH_WORD_SIZE);
+        size_t position = 0;
+        vector<GroundTruth::PlantedWord> manifest; // Planted words in text order
+        manifest.reserve(planted_words.size());
+        Telemetry::ProgressCounter progress("Placed words", planted_words.size());
+        while (remaining_words > 0) {
+            if (uniform_int_distribution<size_t>(0, remaining_units - 1)(gen) < remaining_words) {
+                uint32_t planted_index = placement_order[planted_words.size() - remaining_words];
+                memcpy(text + position, planted_words[planted_index].data(), SEARCH_WORD_SIZE);
+                manifest.push_back(planted_info[planted_index]);
+                manifest.back().position = position;
+                position += SEARCH_WORD_SIZE;
+                remaining_words--;
+                progress.add();
             }
+            else position++;
+            remaining_units--;
         }
+        progress.finish();
 
         // Save to file
-        int status = save_to_file({ text }, RANDOM_GENERATED_TEXT_FILENAME);
-        if (status == 0) cout << "[TextAndSearchWordsGenerator] Successfully generated random text.\n";
-        return status;
+        if (output.close() != 0) {
+            cerr << "[TextAndSearchWordsGenerator] Failed to write file: " << RANDOM_GENERATED_TEXT_FILENAME << ".txt\n";
+            return -1;
+        }
+        cout << "[TextAndSearchWordsGenerator] Successfully generated random text.\n";
+
+        // The letters replace the alphabet of an ingested corpus
+        if (Alphabet::letters(Y_LETTER, 'z').save(ALPHABET_FILENAME) != 0) return -1;
+
+        // Keep where every word was planted, for validating search results without a naive search
+        return GroundTruth::save_manifest(manifest, search_words.size(), seed);
     }
 
     /**
@@ -150,26 +215,35 @@ namespace SearchWordsAndTextGenerator {
      *
      * This function performs two tasks:
      * 1. It generates a list of random search words and saves them to a file.
-     * 2. It generates random text of size `TEXT_SIZE` and inserts the search words and their variants
-     *    at random positions in the text. After inserting all words and variants, the remaining spaces
-     *    are filled with random characters. Finally, the text is saved to a file.
+     * 2. It generates random text of size `TEXT_SIZE` straight into the text file and inserts the
+     *    search words and their variants at random, non-overlapping positions in it. Where they
+     *    were inserted is saved to the ground truth manifest (GROUND_TRUTH_FILENAME).
      *
      * This function ensures that the total size of the search words (including variants) does not exceed
      * the size of the text. If the size condition is violated, it prints an error and terminates the program.
+     * Both are the same for a given RANDOM_TEXT_SEED.
      *
      * @return int 0 on success, -1 on failure.
      */
     int generate_text_and_search_words() {
-        if (NUMBER_OF_SEARCH_WORDS * SEARCH_WORD_SIZE * (NUMBER_OF_VARIATIONS + 1) > TEXT_SIZE) {
+        if (static_cast<uint64_t>(NUMBER_OF_SEARCH_WORDS) * SEARCH_WORD_SIZE * (NUMBER_OF_VARIATIONS + 1) > TEXT_SIZE) {
             cout << "[TextAndSearchWordsGenerator] CRITICAL ERROR - search words total size is bigger then text size! Can't generate the text with those values.\n";
             exit(-1);
         }
 
+        uint64_t seed = RANDOM_TEXT_SEED;
+        if (seed == 0) {
+            random_device rd;
+            seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+        }
+        cout << "[TextAndSearchWordsGenerator] Seed: " << seed << "\n";
+        gen.seed(seed);
+
         if (generate_search_words() != 0) {
             cout << "[TextAndSearchWordsGenerator] Error with search words generation.\n";
             return -1;
         }
 
-        return generate_text();
+        return generate_text(seed);
     }
 }
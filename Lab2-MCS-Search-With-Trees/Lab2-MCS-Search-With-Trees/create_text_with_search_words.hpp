@@ -6,7 +6,12 @@
 #include "config.hpp"
 #include "utils.hpp"
 #include <random>
-#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "WorkStealingScheduler.hpp"
+#include "ground_truth.hpp"
+#include "Alphabet.hpp"
 
 namespace SearchWordsAndTextGenerator {
 
@@ -15,12 +20,13 @@ namespace SearchWordsAndTextGenerator {
      *
      * This function performs two tasks:
      * 1. It generates a list of random search words and saves them to a file.
-     * 2. It generates random text of size `TEXT_SIZE` and inserts the search words and their variants
-     *    at random positions in the text. After inserting all words and variants, the remaining spaces
-     *    are filled with random characters. Finally, the text is saved to a file.
+     * 2. It generates random text of size `TEXT_SIZE` straight into the text file and inserts the
+     *    search words and their variants at random, non-overlapping positions in it. Where they
+     *    were inserted is saved to the ground truth manifest (GROUND_TRUTH_FILENAME).
      *
      * This function ensures that the total size of the search words (including variants) does not exceed
      * the size of the text. If the size condition is violated, it prints an error and terminates the program.
+     * Both are the same for a given RANDOM_TEXT_SEED.
      *
      * @return int 0 on success, -1 on failure.
      */
@@ -0,0 +1,153 @@
+#include "dataset_cache.hpp"
+
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+using namespace Utils;
+
+namespace DatasetCache {
+
+    /**
+     * @brief Cached contents of one file with the size and modification time they were read at.
+     */
+    struct CacheEntry {
+        mutex lock;                         // Held while the file is (re)loaded
+        bool loaded = false;
+        uintmax_t size = 0;
+        filesystem::file_time_type modified;
+        shared_ptr<const MappedText> text;
+        shared_ptr<const vector<string>> lines;
+    };
+
+    typedef unordered_map<string, shared_ptr<CacheEntry>> CacheEntries;
+
+    static mutex entries_lock;
+    static CacheEntries text_entries;
+    static CacheEntries line_entries;
+
+    /**
+     * @brief Returns the entry of a file, creating an empty one on first use.
+     */
+    static shared_ptr<CacheEntry> find_entry(CacheEntries& entries, const string& filename) {
+        lock_guard<mutex> lock(entries_lock);
+        shared_ptr<CacheEntry>& entry = entries[filename];
+        if (!entry) entry = make_shared<CacheEntry>();
+        return entry;
+    }
+
+    /**
+     * @brief Reads the size and modification time of a file.
+     *
+     * @return int 0 on success, -1 if the file does not exist.
+     */
+    static int stat_file(const string& filename, uintmax_t& size, filesystem::file_time_type& modified) {
+        error_code error;
+        size = filesystem::file_size(filename, error);
+        if (!error) modified = filesystem::last_write_time(filename, error);
+        return error ? -1 : 0;
+    }
+
+    /**
+     * @brief Checks whether an entry holds the contents of the file as it is on disk now.
+     */
+    static bool is_fresh(const CacheEntry& entry, uintmax_t size, filesystem::file_time_type modified) {
+        return entry.loaded && entry.size == size && entry.modified == modified;
+    }
+
+    /**
+     * @brief Returns the contents of a text file, mapping it only when it is not cached yet or changed on disk.
+     *
+     * The mapping stays open for the rest of the session, so every menu operation after the
+     * first gets the text without any I/O, and the text is never copied - a multi-gigabyte
+     * text takes its size in memory once. A cached file is remapped when its size or
+     * modification time differs from when it was mapped, or after invalidate() was called
+     * for it. The program invalidates a file before rewriting it.
+     *
+     * @param filename Name of the file to read (".txt" is added if missing).
+     * @param text Set to the cached mapping on success, reset on failure.
+     * @param should_print_log Flag indicating if should print when the file is read from disk.
+     * @return int 0 on success, -1 if the file is missing or empty.
+     */
+    int get_text(const string& filename, shared_ptr<const MappedText>& text, bool should_print_log) {
+        string final_filename = ensure_txt_extension(filename);
+        text.reset();
+
+        uintmax_t size;
+        filesystem::file_time_type modified;
+        if (stat_file(final_filename, size, modified) != 0) {
+            if (should_print_log) cerr << "[DatasetCache] Failed to open file: " << final_filename << '\n';
+            return -1;
+        }
+
+        shared_ptr<CacheEntry> entry = find_entry(text_entries, final_filename);
+        lock_guard<mutex> lock(entry->lock);
+        if (!is_fresh(*entry, size, modified)) {
+            shared_ptr<MappedText> mapped = make_shared<MappedText>();
+            entry->loaded = false;
+            entry->text.reset();
+            if (map_text_from_file(final_filename, *mapped, should_print_log) != 0) return -1;
+
+            entry->text = mapped;
+            entry->size = size;
+            entry->modified = modified;
+            entry->loaded = true;
+        }
+        else if (should_print_log) cout << "[DatasetCache] Using cached file: " << final_filename << '\n';
+
+        text = entry->text;
+        return text->text.empty() ? -1 : 0;
+    }
+
+    /**
+     * @brief Returns the non-empty lines of a file, parsing it only when it is not cached yet or changed on disk.
+     *
+     * Same caching rules as get_text(). Lines are split like Utils::read_lines_from_file.
+     *
+     * @param filename Name of the file to read (".txt" is added if missing).
+     * @param lines Set to the cached lines on success, reset on failure.
+     * @param should_print_log Flag indicating if should print when the file is read from disk.
+     * @return int 0 on success, -1 if the file is missing or has no lines.
+     */
+    int get_lines(const string& filename, shared_ptr<const vector<string>>& lines, bool should_print_log) {
+        string final_filename = ensure_txt_extension(filename);
+        lines.reset();
+
+        uintmax_t size;
+        filesystem::file_time_type modified;
+        if (stat_file(final_filename, size, modified) != 0) {
+            if (should_print_log) cerr << "[DatasetCache] Failed to open file: " << final_filename << '\n';
+            return -1;
+        }
+
+        shared_ptr<CacheEntry> entry = find_entry(line_entries, final_filename);
+        lock_guard<mutex> lock(entry->lock);
+        if (!is_fresh(*entry, size, modified)) {
+            entry->loaded = false;
+            vector<string> parsed = read_lines_from_file(final_filename, should_print_log);
+            if (parsed.empty()) return -1;
+
+            entry->lines = make_shared<const vector<string>>(move(parsed));
+            entry->size = size;
+            entry->modified = modified;
+            entry->loaded = true;
+        }
+        else if (should_print_log) cout << "[DatasetCache] Using cached file: " << final_filename << '\n';
+
+        lines = entry->lines;
+        return 0;
+    }
+
+    /**
+     * @brief Drops the cached contents of a file, so the next get reads it again.
+     *
+     * @param filename Name of the file (".txt" is added if missing).
+     */
+    void invalidate(const string& filename) {
+        string final_filename = ensure_txt_extension(filename);
+        lock_guard<mutex> lock(entries_lock);
+        text_entries.erase(final_filename);
+        line_entries.erase(final_filename);
+    }
+}
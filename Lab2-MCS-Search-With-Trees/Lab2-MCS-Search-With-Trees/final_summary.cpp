@@ -31,13 +31,13 @@ namespace FinalSummary {
                 summary.search_type = line.substr(12);  // Remove "Search Type: "
             }
             else if (line.find("Matches Found:") == 0) {
-                summary.matches_found = stoi(line.substr(14));  // Remove "Matches Found: "
+                summary.matches_found = stoull(line.substr(14));  // Remove "Matches Found: "
             }
             else if (line.find("Time took:") == 0) {
                 summary.time_took = stod(line.substr(11));  // Remove "Time took: "
             }
         }
-        return !summary.search_type.empty() && summary.matches_found >= 0 && summary.time_took >= 0.0;
+        return !summary.search_type.empty() && summary.time_took >= 0.0;
     }
 
     /**
@@ -60,7 +60,8 @@ namespace FinalSummary {
         cout << "\t* MINIMAL_MATCHES=" << MINIMAL_MATCHES << "\n";
         cout << "2. Run the project, and run 5 for creating the filters map, and next 7 for standard mcs search, and lastly 6 for naive search.\n";
         cout << "3. Once all files has ran, copy the summary file of each search into the current directory.\n";
-        cout << "4. You will be required to write the summaries file names, so follow the instructions.\n\n";
+        cout << "4. You will be required to write the summaries file names, so follow the instructions.\n";
+        cout << "To only check that the search results are correct, run 10 instead - it needs no naive search.\n\n";
     }
 
     /**
@@ -0,0 +1,323 @@
+#include "ground_truth.hpp"
+#include "dataset_cache.hpp"
+#include "result_file.hpp"
+#include "WorkStealingScheduler.hpp"
+#include <cstring>
+#include <random>
+#include <unordered_map>
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+using namespace ResultFile;
+
+namespace GroundTruth {
+
+    static_assert(sizeof(GroundTruthHeader) == 64, "GroundTruthHeader layout changed");
+    static_assert(sizeof(PlantedWord) == 16, "PlantedWord layout changed");
+
+    static const size_t MAX_REPORTED_PROBLEMS = 5; // Problems printed per results file, the rest are only counted
+
+    /**
+     * @brief Counts the characters of `word` that differ from the text window starting at `window`.
+     *
+     * @param window The first character of the text window (at least word.size() characters).
+     * @param word The word to compare.
+     * @return uint32_t Number of differing characters.
+     */
+    uint32_t count_mismatches(const char* window, const string& word) {
+        uint32_t mismatches = 0;
+        for (size_t i = 0; i < word.size(); i++) {
+            if (window[i] != word[i]) mismatches++;
+        }
+        return mismatches;
+    }
+
+    /**
+     * @brief Checks if the text window at `position` has at least MINIMAL_MATCHES characters equal to `word`.
+     *
+     * Compared directly against the text, independently of the searches being validated.
+     */
+    static bool is_match(string_view text, size_t position, const string& word) {
+        if (position + word.size() > text.size()) return false;
+
+        const size_t allowed_mismatches = word.size() - MINIMAL_MATCHES;
+        size_t mismatches = 0;
+        for (size_t i = 0; i < word.size(); i++) {
+            if (text[position + i] != word[i] && ++mismatches > allowed_mismatches) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Saves the planted words of a generated text to Config::GROUND_TRUTH_FILENAME.
+     *
+     * @param planted The planted words, sorted by position.
+     * @param words_count Number of search words.
+     * @param seed Seed the text and search words were generated with.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_manifest(const vector<PlantedWord>& planted, size_t words_count, uint64_t seed) {
+        cout << "[GroundTruth] Saving to file: " << GROUND_TRUTH_FILENAME << "\n";
+
+        GroundTruthHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, GROUND_TRUTH_MAGIC, sizeof(header.magic));
+        header.version = GROUND_TRUTH_VERSION;
+        header.byte_order = GROUND_TRUTH_BYTE_ORDER;
+        header.seed = seed;
+        header.text_size = TEXT_SIZE;
+        header.search_word_size = SEARCH_WORD_SIZE;
+        header.minimal_matches = MINIMAL_MATCHES;
+        header.words_count = words_count;
+        header.planted_count = planted.size();
+        header.planted_offset = sizeof(GroundTruthHeader);
+
+        ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+        if (writer.open(GROUND_TRUTH_FILENAME, true) != 0) {
+            cerr << "[GroundTruth] Failed to open file: " << GROUND_TRUTH_FILENAME << '\n';
+            return -1;
+        }
+        writer.write(string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+        writer.write(string_view(reinterpret_cast<const char*>(planted.data()), planted.size() * sizeof(PlantedWord)));
+
+        if (writer.close() != 0) {
+            cerr << "[GroundTruth] Failed to write file: " << GROUND_TRUTH_FILENAME << '\n';
+            return -1;
+        }
+        cout << "[GroundTruth] File saved successfully: " << GROUND_TRUTH_FILENAME << " (" << planted.size() << " planted words)\n";
+        return 0;
+    }
+
+    /**
+     * @brief Maps the manifest and checks that it describes the current text and search words.
+     *
+     * Every planted copy is compared with the text, so a manifest left over from another
+     * generated text is rejected.
+     *
+     * @return int 0 on success, -1 if the manifest is missing, corrupted or out of date.
+     */
+    static int load_manifest(MappedFile& file, GroundTruthHeader& header, string_view text, const vector<string>& search_words) {
+        if (file.open(GROUND_TRUTH_FILENAME, MappedFile::Access::SEQUENTIAL) != 0) {
+            cerr << "[GroundTruth] Failed to map file: " << GROUND_TRUTH_FILENAME << " - generate the text again (option 2) to create it.\n";
+            return -1;
+        }
+        if (file.size() < sizeof(header)) {
+            cerr << "[GroundTruth] Manifest is truncated: " << GROUND_TRUTH_FILENAME << '\n';
+            return -1;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+
+        if (memcmp(header.magic, GROUND_TRUTH_MAGIC, sizeof(header.magic)) != 0 || header.version != GROUND_TRUTH_VERSION ||
+            header.byte_order != GROUND_TRUTH_BYTE_ORDER || header.planted_offset % alignof(PlantedWord) != 0 ||
+            header.planted_offset + header.planted_count * sizeof(PlantedWord) > file.size()) {
+            cerr << "[GroundTruth] Manifest rejected - not a manifest of this version or corrupted: " << GROUND_TRUTH_FILENAME << '\n';
+            return -1;
+        }
+
+        if (header.text_size != text.size() || header.search_word_size != static_cast<uint32_t>(SEARCH_WORD_SIZE) ||
+            header.words_count != search_words.size()) {
+            cerr << "[GroundTruth] Manifest does not belong to the current text and search words - generate them again (option 2).\n";
+            return -1;
+        }
+
+        const PlantedWord* planted = reinterpret_cast<const PlantedWord*>(file.data() + header.planted_offset);
+        for (uint64_t i = 0; i < header.planted_count; i++) {
+            if (planted[i].word_id >= search_words.size() || planted[i].position + SEARCH_WORD_SIZE > text.size() ||
+                count_mismatches(text.data() + planted[i].position, search_words[planted[i].word_id]) != planted[i].mismatches) {
+                cerr << "[GroundTruth] Manifest does not match the current text at position " << planted[i].position
+                     << " - generate the text again (option 2).\n";
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Naively compares every search word against GROUND_TRUTH_SAMPLE_POSITIONS random text positions.
+     *
+     * All positions are scanned when the text has fewer. The positions are drawn from the
+     * manifest seed, so repeated validations scan the same sample.
+     *
+     * @return vector<WordHit> The matches found in the sample, sorted.
+     */
+    static vector<WordHit> scan_sample(string_view text, const vector<string>& search_words, uint64_t seed, size_t& scanned_count) {
+        size_t windows_count = text.size() >= static_cast<size_t>(SEARCH_WORD_SIZE) ? text.size() - SEARCH_WORD_SIZE + 1 : 0;
+        vector<size_t> positions;
+        if (GROUND_TRUTH_SAMPLE_POSITIONS >= windows_count) {
+            positions.resize(windows_count);
+            for (size_t i = 0; i < windows_count; i++) positions[i] = i;
+        }
+        else if (windows_count > 0) {
+            mt19937_64 gen(seed);
+            uniform_int_distribution<size_t> position_dist(0, windows_count - 1);
+            positions.resize(GROUND_TRUTH_SAMPLE_POSITIONS);
+            for (size_t& position : positions) position = position_dist(gen);
+        }
+        scanned_count = positions.size();
+
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
+        scheduler.run(positions.size(), [&](unsigned worker, size_t task) {
+            for (size_t word_index = 0; word_index < search_words.size(); word_index++) {
+                if (is_match(text, positions[task], search_words[word_index]))
+                    thread_hits[worker].push_back({ word_index, positions[task] });
+            }
+        }, true);
+
+        vector<WordHit> hits;
+        for (const vector<WordHit>& worker_hits : thread_hits)
+            hits.insert(hits.end(), worker_hits.begin(), worker_hits.end());
+        sort(hits.begin(), hits.end());
+        hits.erase(unique(hits.begin(), hits.end(),
+            [](const WordHit& a, const WordHit& b) { return a.word_index == b.word_index && a.position == b.position; }), hits.end());
+        return hits;
+    }
+
+    /**
+     * @brief Counts the expected matches missing from a results file, printing the first few.
+     *
+     * @param found The result positions of every word, sorted.
+     */
+    static size_t count_missing(const vector<WordHit>& expected, const vector<vector<uint64_t>>& found,
+        const vector<string>& search_words, const char* kind, size_t& reported) {
+        size_t missing = 0;
+        for (const WordHit& hit : expected) {
+            const vector<uint64_t>& positions = found[hit.word_index];
+            if (binary_search(positions.begin(), positions.end(), hit.position)) continue;
+
+            missing++;
+            if (reported++ < MAX_REPORTED_PROBLEMS)
+                cout << "[GroundTruth]   Missing " << kind << " match: " << search_words[hit.word_index] << " at " << hit.position << '\n';
+        }
+        return missing;
+    }
+
+    /**
+     * @brief Checks one binary results file against the planted and the sampled matches.
+     *
+     * @return int 0 if the results passed, -1 otherwise.
+     */
+    static int validate_results_file(const string& filename, string_view text, const vector<string>& search_words,
+        const vector<WordHit>& planted_hits, const vector<WordHit>& sampled_hits) {
+        MappedFile file;
+        ResultFileHeader header;
+        if (map_results(filename, file, header) != 0) return -1;
+
+        if (header.text_size != text.size() || header.search_word_size != static_cast<uint32_t>(SEARCH_WORD_SIZE) ||
+            header.minimal_matches != static_cast<uint32_t>(MINIMAL_MATCHES)) {
+            cerr << "[GroundTruth] " << filename << " was searched with another text or config - run the search again.\n";
+            return -1;
+        }
+
+        // === Group the result positions by search word, checking each of them against the text ===
+        unordered_map<string_view, uint32_t> word_ids;
+        for (size_t i = 0; i < search_words.size(); i++) word_ids.emplace(search_words[i], static_cast<uint32_t>(i));
+
+        const uint64_t* word_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.word_offsets_offset);
+        const uint64_t* position_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.position_offsets_offset);
+        const char* word_chars = file.data() + header.word_chars_offset;
+
+        vector<vector<uint64_t>> found(search_words.size());
+        size_t invalid = 0;
+        size_t reported = 0;
+        for (uint64_t i = 0; i < header.words_count; i++) {
+            string_view word(word_chars + word_offsets[i], static_cast<size_t>(word_offsets[i + 1] - word_offsets[i]));
+            auto word_id = word_ids.find(word);
+            size_t count = static_cast<size_t>(position_offsets[i + 1] - position_offsets[i]);
+            if (word_id == word_ids.end()) {
+                invalid += count;
+                if (reported++ < MAX_REPORTED_PROBLEMS) cout << "[GroundTruth]   Unknown search word: " << word << '\n';
+                continue;
+            }
+
+            vector<uint64_t>& word_positions = found[word_id->second];
+            for (uint64_t p = position_offsets[i]; p < position_offsets[i + 1]; p++) {
+                uint64_t position = read_position(file, header, p);
+                if (is_match(text, position, search_words[word_id->second])) {
+                    word_positions.push_back(position);
+                    continue;
+                }
+                invalid++;
+                if (reported++ < MAX_REPORTED_PROBLEMS) cout << "[GroundTruth]   Invalid match: " << word << " at " << position << '\n';
+            }
+            sort(word_positions.begin(), word_positions.end());
+        }
+
+        // === Every expected match must be in the results ===
+        size_t missing_planted = count_missing(planted_hits, found, search_words, "planted", reported);
+        size_t missing_sampled = count_missing(sampled_hits, found, search_words, "sampled", reported);
+
+        bool passed = invalid == 0 && missing_planted == 0 && missing_sampled == 0;
+        cout << "[GroundTruth] " << filename << " (" << header.engine << "): " << header.positions_count << " results | planted "
+             << planted_hits.size() - missing_planted << "/" << planted_hits.size() << " | sampled incidental "
+             << sampled_hits.size() - missing_sampled << "/" << sampled_hits.size() << " | invalid " << invalid
+             << (passed ? " -> PASSED\n" : " -> FAILED\n");
+        return passed ? 0 : -1;
+    }
+
+    /**
+     * @brief Checks the results of every search in Config::SEARCH_OUTPUT_FILENAMES against the ground truth manifest.
+     *
+     * Every planted copy close enough to its word must be in the results, every result must
+     * really match the text, and every incidental match found by a naive scan of
+     * GROUND_TRUTH_SAMPLE_POSITIONS random text positions must be in the results too.
+     *
+     * @return int 0 if all results passed, -1 on failure or if any results failed.
+     */
+    int run_ground_truth_validation() {
+        cout << "[GroundTruth] Starting validation of the search results...\n";
+
+        // === Phase 1: Load the text, the search words and the manifest ===
+        shared_ptr<const MappedText> text;
+        shared_ptr<const vector<string>> search_words;
+        if (DatasetCache::get_text(RANDOM_GENERATED_TEXT_FILENAME, text) != 0 ||
+            DatasetCache::get_lines(SEARCH_WORDS_FILENAME, search_words) != 0) {
+            cerr << "[GroundTruth] Failed to load the text or the search words.\n";
+            return -1;
+        }
+
+        // The text file ends with a newline after the generated letters
+        string_view letters = without_line_break(text->text);
+
+        MappedFile manifest;
+        GroundTruthHeader header;
+        if (load_manifest(manifest, header, letters, *search_words) != 0) return -1;
+
+        // === Phase 2: Planted copies with at least MINIMAL_MATCHES equal characters must be found ===
+        vector<WordHit> planted_hits;
+        const PlantedWord* planted = reinterpret_cast<const PlantedWord*>(manifest.data() + header.planted_offset);
+        for (uint64_t i = 0; i < header.planted_count; i++) {
+            if (SEARCH_WORD_SIZE - planted[i].mismatches >= static_cast<uint32_t>(MINIMAL_MATCHES))
+                planted_hits.push_back({ planted[i].word_id, static_cast<size_t>(planted[i].position) });
+        }
+        sort(planted_hits.begin(), planted_hits.end());
+        cout << "[GroundTruth] " << planted_hits.size() << " of " << header.planted_count << " planted words are expected matches.\n";
+
+        // === Phase 3: Incidental matches of the random letters, from a naive scan of a sample ===
+        size_t scanned_count = 0;
+        vector<WordHit> sampled_hits;
+        for (const WordHit& hit : scan_sample(letters, *search_words, header.seed, scanned_count)) {
+            if (!binary_search(planted_hits.begin(), planted_hits.end(), hit)) sampled_hits.push_back(hit);
+        }
+        cout << "[GroundTruth] Scanned " << scanned_count << " text positions, found " << sampled_hits.size() << " incidental matches.\n";
+
+        // === Phase 4: Check every results file that exists ===
+        int passed = 0;
+        int failed = 0;
+        for (const string& filename : SEARCH_OUTPUT_FILENAMES) {
+            if (!ifstream(filename + RESULT_FILE_EXTENSION).good()) continue;
+
+            if (validate_results_file(filename, letters, *search_words, planted_hits, sampled_hits) == 0) passed++;
+            else failed++;
+        }
+
+        if (passed == 0 && failed == 0) {
+            cerr << "[GroundTruth] No binary results found - run a search first.\n";
+            return -1;
+        }
+
+        cout << "[GroundTruth] Validation complete: " << passed << " passed, " << failed << " failed.\n";
+        return failed == 0 ? 0 : -1;
+    }
+}
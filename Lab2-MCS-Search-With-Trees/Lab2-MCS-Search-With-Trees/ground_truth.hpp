@@ -0,0 +1,73 @@
+#ifndef GROUND_TRUTH_HPP
+#define GROUND_TRUTH_HPP
+
+#include "utils.hpp"
+#include "config.hpp"
+#include "WordMatch.hpp"
+#include <cstdint>
+
+namespace GroundTruth {
+
+    /**
+     * @brief Fixed-size header at the start of the ground truth manifest.
+     *
+     * The header is followed by `planted_count` PlantedWord entries, sorted by position.
+     */
+    struct GroundTruthHeader {
+        char magic[8];                      // GROUND_TRUTH_MAGIC
+        uint32_t version;                   // GROUND_TRUTH_VERSION
+        uint32_t byte_order;                // GROUND_TRUTH_BYTE_ORDER as written by the creating machine
+        uint64_t seed;                      // Seed the text and search words were generated with
+        uint64_t text_size;                 // Config::TEXT_SIZE
+        uint32_t search_word_size;          // Config::SEARCH_WORD_SIZE
+        uint32_t minimal_matches;           // Config::MINIMAL_MATCHES when the text was generated
+        uint64_t words_count;               // Number of search words the word ids refer to
+        uint64_t planted_count;
+        uint64_t planted_offset;
+    };
+
+    /**
+     * @brief A search word or one of its variants, as inserted into the generated text.
+     */
+    struct PlantedWord {
+        uint64_t position;                  // Start of the inserted copy in the text
+        uint32_t word_id;                   // Line of the search word in the search words file
+        uint32_t mismatches;                // Characters of the copy that differ from the search word
+    };
+
+    const char GROUND_TRUTH_MAGIC[8] = { 'M', 'C', 'S', 'G', 'T', '\0', '\0', '\0' };
+    const uint32_t GROUND_TRUTH_VERSION = 1;
+    const uint32_t GROUND_TRUTH_BYTE_ORDER = 0x01020304;
+
+    /**
+     * @brief Counts the characters of `word` that differ from the text window starting at `window`.
+     *
+     * @param window The first character of the text window (at least word.size() characters).
+     * @param word The word to compare.
+     * @return uint32_t Number of differing characters.
+     */
+    uint32_t count_mismatches(const char* window, const std::string& word);
+
+    /**
+     * @brief Saves the planted words of a generated text to Config::GROUND_TRUTH_FILENAME.
+     *
+     * @param planted The planted words, sorted by position.
+     * @param words_count Number of search words.
+     * @param seed Seed the text and search words were generated with.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_manifest(const vector<PlantedWord>& planted, size_t words_count, uint64_t seed);
+
+    /**
+     * @brief Checks the results of every search in Config::SEARCH_OUTPUT_FILENAMES against the ground truth manifest.
+     *
+     * Every planted copy close enough to its word must be in the results, every result must
+     * really match the text, and every incidental match found by a naive scan of
+     * GROUND_TRUTH_SAMPLE_POSITIONS random text positions must be in the results too.
+     *
+     * @return int 0 if all results passed, -1 on failure or if any results failed.
+     */
+    int run_ground_truth_validation();
+}
+
+#endif
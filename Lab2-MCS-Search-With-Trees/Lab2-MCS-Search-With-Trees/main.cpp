@@ -8,6 +8,11 @@ using namespace SearchWordsAndTextGenerator;
 using namespace Create_MCS_Tree;
 using namespace Tree_MCS_Search;
 using namespace FinalSummary;
+using namespace Create_Adaptive_MCS_Tree;
+using namespace Adaptive_Tree_MCS_Search;
+using namespace ResultFile;
+using namespace GroundTruth;
+using namespace CorpusIngestion;
 
 int main() {
     int choice;
@@ -35,6 +40,24 @@ int main() {
         case 5:
             handle_operation(create_final_summary, choice);
             break;
+        case 6:
+            handle_operation(create_adaptive_mcs_tree, choice);
+            break;
+        case 7:
+            handle_operation(run_adaptive_tree_mcs_search, choice);
+            break;
+        case 8:
+            handle_operation(run_tree_mcs_search_scaling, choice);
+            break;
+        case 9:
+            handle_operation(run_results_conversion, choice);
+            break;
+        case 10:
+            handle_operation(run_ground_truth_validation, choice);
+            break;
+        case 11:
+            handle_operation(run_corpus_ingestion, choice);
+            break;
         case 0:
             cout << "Exiting program. Goodbye!\n";
             return 0;
@@ -10,5 +10,10 @@
 #include "create_mcs_tree.hpp"
 #include "mcs_tree_search.hpp"
 #include "final_summary.hpp"
+#include "create_adaptive_mcs_tree.hpp"
+#include "adaptive_mcs_tree_search.hpp"
+#include "result_file.hpp"
+#include "ground_truth.hpp"
+#include "corpus_ingestion.hpp"
 
 #endif
\ No newline at end of file
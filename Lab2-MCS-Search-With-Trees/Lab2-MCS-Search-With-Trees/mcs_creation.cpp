@@ -25,6 +25,7 @@ namespace MCS {
 
         const int total_range = static_cast<int>(end - start);
         int generated_count = 0;
+        Telemetry::ProgressCounter progress("Combinations", total_range);
 
         for (unsigned long long i = end - 1; i >= start; --i) {
             bitset<SEARCH_WORD_SIZE> bits(i);  // Convert to fixed-size binary string
@@ -33,8 +34,7 @@ namespace MCS {
                 combinations.push_back(binary);
             }
 
-            ++generated_count;
-            print_progress(generated_count, total_range);
+            progress.set(++generated_count);
 
             if (i == start) break;  // avoid infinite loop on unsigned underflow
         }
@@ -99,6 +99,7 @@ namespace MCS {
 
         // === Step 2: Create the minimal set cover (MCS) ===
         int processed = 0;
+        Telemetry::ProgressCounter progress("Set cover", total_combinations);
 
         for (const auto& value : all_valid_combinations) {
             bool skip = false;
@@ -109,8 +110,7 @@ namespace MCS {
                 if (skip) break;
             }
             if (skip) {
-                ++processed;
-                print_progress(processed, total_combinations);
+                progress.set(++processed);
                 continue;
             }
 
@@ -132,9 +132,9 @@ namespace MCS {
                 mcs.push_back(truncated);
             }
 
-            ++processed;
-            print_progress(processed, total_combinations);
+            progress.set(++processed);
         }
+        progress.finish();
 
         // === Step 3: Save result to output file ===
         int status = save_to_file(mcs, MCS_OUTPUT_FILENAME);
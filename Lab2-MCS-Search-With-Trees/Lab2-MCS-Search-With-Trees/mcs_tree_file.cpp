@@ -0,0 +1,298 @@
+#include "mcs_tree_file.hpp"
+#include <cstring>
+#include <filesystem>
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+
+namespace MCS_Tree_File {
+
+    /**
+     * @brief Computes the 64-bit FNV-1a hash of a byte range, continuing from `hash`.
+     */
+    static uint64_t fnv1a(const char* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hashes a byte range 8 bytes at a time in four independent lanes.
+     *
+     * Used for the text, which is hashed on every load - byte-at-a-time FNV-1a is several
+     * times slower there. The tail that does not fill a 32-byte block goes through FNV-1a.
+     */
+    static uint64_t block_hash(const char* data, size_t size) {
+        const uint64_t prime1 = 0x9E3779B185EBCA87ull;
+        const uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+        uint64_t lanes[4] = { prime1 + prime2, prime2, 0, 0 - prime1 };
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (size_t lane = 0; lane < 4; ++lane) {
+                uint64_t word;
+                memcpy(&word, data + i + lane * sizeof(word), sizeof(word));
+                uint64_t value = lanes[lane] + word * prime2;
+                lanes[lane] = ((value << 31) | (value >> 33)) * prime1;
+            }
+        }
+
+        uint64_t hash = fnv1a(data + i, size - i, fnv1a(nullptr, 0) ^ size);
+        for (uint64_t lane : lanes) {
+            hash = (hash ^ lane) * prime1;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hashes the filters as one newline-separated block.
+     */
+    static uint64_t filters_checksum(const vector<string>& filters) {
+        uint64_t hash = fnv1a(nullptr, 0);
+        for (const string& filter : filters) {
+            hash = fnv1a(filter.data(), filter.size(), hash);
+            hash = fnv1a("\n", 1, hash);
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Rounds a file offset up to the next 64-byte boundary.
+     */
+    static uint64_t align_offset(uint64_t offset) {
+        return (offset + 63) & ~uint64_t(63);
+    }
+
+    /**
+     * @brief Fills the header fields that describe the current config and inputs.
+     */
+    static void fill_header(TreeFileHeader& header, string_view text, const vector<string>& filters, const Alphabet& alphabet) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, TREE_FILE_MAGIC, sizeof(header.magic));
+        header.version = TREE_FILE_VERSION;
+        header.byte_order = TREE_FILE_BYTE_ORDER;
+        header.element_size = static_cast<uint32_t>(alphabet.fanout() * sizeof(uint32_t));
+        header.alphabet_size = static_cast<uint32_t>(alphabet.fanout());
+        header.alphabet_checksum = static_cast<uint32_t>(alphabet.checksum());
+        header.search_word_size = SEARCH_WORD_SIZE;
+        header.filter_matches = FILTER_NUMBER_OF_MATCHES;
+        header.position_size = sizeof(TextPosition);
+        header.text_size = text.size();
+        header.text_checksum = block_hash(text.data(), text.size());
+        header.filters_checksum = filters_checksum(filters);
+    }
+
+    /**
+     * @brief Fills the header fields that describe the sections of the global tree.
+     */
+    static void fill_layout(TreeFileHeader& header) {
+        header.nodes_count = tree_data_array.nodes.size();
+        header.leaves_count = tree_data_array.leaves_count;
+        header.positions_count = tree_data_array.postings.positions.size();
+        header.nodes_offset = align_offset(sizeof(TreeFileHeader));
+        header.offsets_offset = align_offset(header.nodes_offset + header.nodes_count * header.element_size);
+        header.positions_offset = align_offset(header.offsets_offset + (header.leaves_count + 1) * sizeof(uint64_t));
+    }
+
+    /**
+     * @brief Size in bytes of the file save_mcs_tree() would write for the global tree.
+     */
+    uint64_t saved_file_size() {
+        TreeFileHeader header;
+        memset(&header, 0, sizeof(header));
+        header.element_size = static_cast<uint32_t>(tree_data_array.alphabet.fanout() * sizeof(uint32_t));
+        fill_layout(header);
+        return header.positions_offset + header.positions_count * sizeof(TextPosition);
+    }
+
+    /**
+     * @brief Writes zero bytes until the stream reaches the given offset.
+     */
+    static void pad_to(ofstream& out, uint64_t offset) {
+        static const char zeros[64] = {};
+        uint64_t current = static_cast<uint64_t>(out.tellp());
+        if (offset > current) out.write(zeros, static_cast<streamsize>(offset - current));
+    }
+
+    /**
+     * @brief Saves the global tree (elements and posting lists) to Config::MCS_TREE_FILENAME.
+     *
+     * Nothing is written when the disk does not have room for the whole file.
+     *
+     * @param text The text the tree was built from.
+     * @param filters The MCS filters the tree was built from.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_mcs_tree(string_view text, const vector<string>& filters) {
+        if (tree_data_array.empty() || tree_data_array.is_mapped()) {
+            cerr << "[MCSTreeFile] Nothing to save - no tree was built in this run.\n";
+            return -1;
+        }
+
+        const SlabRows<uint32_t>& nodes = tree_data_array.nodes;
+        const PostingLists& postings = tree_data_array.postings;
+
+        TreeFileHeader header;
+        fill_header(header, text, filters, tree_data_array.alphabet);
+        fill_layout(header);
+
+        // Refuse up front rather than fail after writing gigabytes
+        const uint64_t file_size = header.positions_offset + header.positions_count * header.position_size;
+        error_code error;
+        filesystem::space_info disk = filesystem::space(filesystem::absolute(MCS_TREE_FILENAME).parent_path(), error);
+        if (!error && disk.available < file_size) {
+            cerr << "[MCSTreeFile] Not enough disk space for " << MCS_TREE_FILENAME << ": " << file_size / (1024 * 1024)
+                 << " MB needed, " << disk.available / (1024 * 1024) << " MB available.\n";
+            return -1;
+        }
+
+        ofstream out(MCS_TREE_FILENAME, ios::binary | ios::trunc);
+        if (!out) {
+            cerr << "[MCSTreeFile] Failed to open file: " << MCS_TREE_FILENAME << '\n';
+            return -1;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        pad_to(out, header.nodes_offset);
+        for (size_t i = 0; i < nodes.size(); ++i)
+            out.write(reinterpret_cast<const char*>(nodes[i]), header.element_size);
+        pad_to(out, header.offsets_offset);
+        out.write(reinterpret_cast<const char*>(postings.offsets.data()), static_cast<streamsize>(postings.offsets.size() * sizeof(uint64_t)));
+        pad_to(out, header.positions_offset);
+        out.write(reinterpret_cast<const char*>(postings.positions.data()), static_cast<streamsize>(postings.positions.size() * sizeof(TextPosition)));
+
+        if (!out) {
+            cerr << "[MCSTreeFile] Failed to write file: " << MCS_TREE_FILENAME << '\n';
+            return -1;
+        }
+
+        cout << "[MCSTreeFile] Tree saved to " << MCS_TREE_FILENAME << " ("
+             << static_cast<uint64_t>(out.tellp()) / (1024 * 1024) << " MB).\n";
+        return 0;
+    }
+
+    /**
+     * @brief Checks every pointer, posting offset and position of a mapped tree against its header.
+     *
+     * Searches follow the mapped sections without bounds checks, so a corrupted file must not
+     * get that far. Child pointers must address an element, leaf pointers a leaf, the posting
+     * offsets must be non-decreasing and end at positions_count, and positions must lie in the text.
+     * This reads every page of the file, so load_mcs_tree() only runs it with Config::VERIFY_MCS_TREE_FILE.
+     *
+     * @param data The mapped file, already checked to hold every section.
+     * @param header The header of the file.
+     * @return const char* The reason the file is rejected, or nullptr if it is consistent.
+     */
+    static const char* check_sections(const char* data, const TreeFileHeader& header) {
+        const uint32_t* nodes = reinterpret_cast<const uint32_t*>(data + header.nodes_offset);
+        const uint64_t pointers_count = header.nodes_count * header.alphabet_size;
+        for (uint64_t i = 0; i < pointers_count; ++i) {
+            const uint32_t pointer = nodes[i];
+            if (pointer == TreeArrayElement::EMPTY) continue;
+            const uint64_t limit = TreeArrayElement::is_leaf(pointer) ? header.leaves_count : header.nodes_count;
+            if (TreeArrayElement::index_of(pointer) >= limit) return "tree pointers are corrupted";
+        }
+
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + header.offsets_offset);
+        if (offsets[0] != 0 || offsets[header.leaves_count] != header.positions_count) return "posting lists are corrupted";
+        for (uint64_t leaf = 0; leaf < header.leaves_count; ++leaf)
+            if (offsets[leaf] > offsets[leaf + 1]) return "posting lists are corrupted";
+
+        const TextPosition* positions = reinterpret_cast<const TextPosition*>(data + header.positions_offset);
+        for (uint64_t i = 0; i < header.positions_count; ++i)
+            if (positions[i] >= header.text_size) return "posting positions are out of the text";
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Maps Config::MCS_TREE_FILENAME into the global tree without copying it.
+     *
+     * The file is rejected when its format, config, alphabet, text checksum or filters checksum
+     * do not match the current program and input files, or when a section points outside its bounds.
+     * Only the header and the ends of the posting offsets are read, so the sections are paged in
+     * by the search as it touches them. Config::VERIFY_MCS_TREE_FILE adds a scan of every section.
+     *
+     * @return int 0 on success, -1 on failure (the tree is left empty).
+     */
+    int load_mcs_tree() {
+        tree_data_array.clear();
+
+        MappedText mapped_text;
+        map_text_from_file(RANDOM_GENERATED_TEXT_FILENAME, mapped_text);
+        string_view text = without_line_break(mapped_text.text);
+        vector<string> filters = read_lines_from_file(MCS_OUTPUT_FILENAME);
+        Alphabet alphabet;
+        if (text.empty() || filters.empty() || Alphabet::load_current(alphabet) != 0) {
+            cerr << "[MCSTreeFile] Failed to load the text, the MCS filters or the alphabet.\n";
+            return -1;
+        }
+
+        MappedFile& file = tree_data_array.mapped_file;
+        if (file.open(MCS_TREE_FILENAME) != 0) {
+            cerr << "[MCSTreeFile] Failed to map file: " << MCS_TREE_FILENAME << '\n';
+            return -1;
+        }
+
+        // === Validate the header against the current config and inputs ===
+        TreeFileHeader expected;
+        fill_header(expected, text, filters, alphabet);
+
+        TreeFileHeader header;
+        if (file.size() < sizeof(header)) {
+            cerr << "[MCSTreeFile] Tree file is truncated.\n";
+            file.close();
+            return -1;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+
+        const char* mismatch = nullptr;
+        if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) mismatch = "not a tree file";
+        else if (header.version != expected.version) mismatch = "unsupported version";
+        else if (header.byte_order != expected.byte_order) mismatch = "written on a machine with a different byte order";
+        else if (header.search_word_size != expected.search_word_size || header.filter_matches != expected.filter_matches ||
+                 header.position_size != expected.position_size) mismatch = "built with a different config";
+        else if (header.element_size != expected.element_size || header.alphabet_size != expected.alphabet_size ||
+                 header.alphabet_checksum != expected.alphabet_checksum) mismatch = "built for a different alphabet";
+        else if (header.text_size != expected.text_size || header.text_checksum != expected.text_checksum) mismatch = "built from a different text";
+        else if (header.filters_checksum != expected.filters_checksum) mismatch = "built from different MCS filters";
+        else if (header.nodes_count == 0 || header.nodes_count >= TreeArrayElement::LEAF_FLAG ||
+                 header.leaves_count >= TreeArrayElement::LEAF_FLAG ||
+                 // The offsets are bounded by the file size first, so the section ends below cannot overflow
+                 header.nodes_offset > file.size() || header.offsets_offset > file.size() || header.positions_offset > file.size() ||
+                 header.nodes_offset % alignof(uint32_t) != 0 ||
+                 header.positions_count > file.size() / sizeof(TextPosition) ||
+                 header.offsets_offset % alignof(uint64_t) != 0 || header.positions_offset % alignof(TextPosition) != 0 ||
+                 header.nodes_offset + header.nodes_count * header.element_size > file.size() ||
+                 header.offsets_offset + (header.leaves_count + 1) * sizeof(uint64_t) > file.size() ||
+                 header.positions_offset + header.positions_count * sizeof(TextPosition) > file.size()) mismatch = "sections are out of bounds";
+
+        if (mismatch == nullptr) {
+            const uint64_t* offsets = reinterpret_cast<const uint64_t*>(file.data() + header.offsets_offset);
+            if (offsets[0] != 0 || offsets[header.leaves_count] != header.positions_count) mismatch = "posting lists are corrupted";
+        }
+        if (mismatch == nullptr && VERIFY_MCS_TREE_FILE) mismatch = check_sections(file.data(), header);
+
+        if (mismatch != nullptr) {
+            cerr << "[MCSTreeFile] Tree file rejected - " << mismatch << ". Run MCS Tree Creation again.\n";
+            file.close();
+            return -1;
+        }
+
+        // === Point the tree at the mapped sections ===
+        tree_data_array.alphabet = alphabet;
+        tree_data_array.mapped_nodes = reinterpret_cast<const uint32_t*>(file.data() + header.nodes_offset);
+        tree_data_array.mapped_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.offsets_offset);
+        tree_data_array.mapped_positions = reinterpret_cast<const TextPosition*>(file.data() + header.positions_offset);
+        tree_data_array.mapped_nodes_count = static_cast<size_t>(header.nodes_count);
+        tree_data_array.leaves_count = static_cast<uint32_t>(header.leaves_count);
+
+        cout << "[MCSTreeFile] Mapped tree from " << MCS_TREE_FILENAME << " with " << header.nodes_count
+             << " elements of " << header.alphabet_size << " pointers and " << header.leaves_count << " leaves.\n";
+        return 0;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef MCS_TREE_FILE_HPP
+#define MCS_TREE_FILE_HPP
+
+#include "utils.hpp"
+#include "config.hpp"
+#include "TreeArrayElement.hpp"
+#include "TreeDataArray.hpp"
+#include "Alphabet.hpp"
+#include <cstdint>
+
+namespace MCS_Tree_File {
+
+    /**
+     * @brief Fixed-size header at the start of the tree file.
+     *
+     * Every section is addressed by its byte offset from the start of the file, so the file
+     * can be mapped at any address and searched in place. The config fields and checksums
+     * tie the file to the text and filters it was built from.
+     */
+    struct TreeFileHeader {
+        char magic[8];                  // TREE_FILE_MAGIC
+        uint32_t version;               // TREE_FILE_VERSION
+        uint32_t byte_order;            // TREE_FILE_BYTE_ORDER as written by the creating machine
+        uint32_t element_size;          // Bytes per element, alphabet_size pointers
+        uint32_t alphabet_size;         // Alphabet::fanout() of the text - its symbols and '$'
+        uint32_t alphabet_checksum;     // Low 32 bits of Alphabet::checksum()
+        uint32_t search_word_size;      // Config::SEARCH_WORD_SIZE
+        uint32_t filter_matches;        // Config::FILTER_NUMBER_OF_MATCHES
+        uint32_t position_size;         // sizeof(Config::TextPosition)
+        uint64_t text_size;
+        uint64_t text_checksum;         // Block hash of the text
+        uint64_t filters_checksum;      // FNV-1a of the filters, one per line
+        uint64_t nodes_count;
+        uint64_t leaves_count;
+        uint64_t positions_count;
+        uint64_t nodes_offset;          // nodes_count elements of element_size bytes
+        uint64_t offsets_offset;        // leaves_count + 1 uint64 posting offsets
+        uint64_t positions_offset;      // positions_count text positions of position_size bytes
+    };
+
+    const char TREE_FILE_MAGIC[8] = { 'M', 'C', 'S', 'T', 'R', 'E', 'E', '\0' };
+    const uint32_t TREE_FILE_VERSION = 3;
+    const uint32_t TREE_FILE_BYTE_ORDER = 0x01020304;
+
+    /**
+     * @brief Size in bytes of the file save_mcs_tree() would write for the global tree.
+     */
+    uint64_t saved_file_size();
+
+    /**
+     * @brief Saves the global tree (elements and posting lists) to Config::MCS_TREE_FILENAME.
+     *
+     * Nothing is written when the disk does not have room for the whole file.
+     *
+     * @param text The text the tree was built from.
+     * @param filters The MCS filters the tree was built from.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_mcs_tree(std::string_view text, const vector<std::string>& filters);
+
+    /**
+     * @brief Maps Config::MCS_TREE_FILENAME into the global tree without copying it.
+     *
+     * The file is rejected when its format, config, alphabet, text checksum or filters checksum
+     * do not match the current program and input files, or when a section points outside its bounds.
+     * Only the header and the ends of the posting offsets are read, so the sections are paged in
+     * by the search as it touches them. Config::VERIFY_MCS_TREE_FILE adds a scan of every section.
+     *
+     * @return int 0 on success, -1 on failure (the tree is left empty).
+     */
+    int load_mcs_tree();
+}
+
+#endif
@@ -4,7 +4,7 @@ using namespace std;
 using namespace chrono;
 using namespace Utils;
 using namespace Config;
-using namespace Create_MCS_Tree;
+using namespace ResultFile;
 
 namespace Tree_MCS_Search {
 
@@ -24,7 +24,7 @@ namespace Tree_MCS_Search {
      *         false otherwise.
      *
      */
-    inline static bool check_matches(const string& text, size_t text_index, const string& word) {
+    inline static bool check_matches(string_view text, size_t text_index, const string& word) {
         if (text_index > text.size() || text_index + word.length() > text.size()) {
             return false;
         }
@@ -42,158 +42,272 @@ namespace Tree_MCS_Search {
     }
 
     /**
-     * @brief Recursively collects positions of matches from the tree data structure.
+     * @brief Collects the candidate alignment starts of a word from the array tree.
      *
-     * This function traverses the tree nodes to find matching positions for a given word
-     * starting at a certain offset and depth. It collects the positions of matching
-     * substrings and stores them in the output set.
+     * Walks the tree with an explicit stack that is seeded with the root once per word
+     * offset, so every offset is handled in a single traversal. At each node both the
+     * letter branch and the '$' branch are followed, and the positions of every reached
+     * leaf are added to `candidates`. A word letter outside the tree's alphabet only
+     * follows the '$' branch.
      *
-     * @param node The current node of the tree to explore.
      * @param word The word to search for in the tree.
-     * @param offset The current offset within the word to match.
-     * @param depth The current depth in the tree to traverse.
-     * @param out The set to store the resulting matching positions.
+     * @param candidates The set to add the alignment starts to.
      */
-    static void collect_positions_from_tree(TreeNode* node, const string& word, size_t offset, size_t depth, unordered_set<size_t>& out) {
-        if (!node || offset + depth >= word.length()) return;
-
-        int idx = index_fixer(word[offset + depth]);
-        int dollar_idx = index_fixer('$');
-
-        // Check letter path
-        if (node->pointers[idx]) {
-            void* ptr = node->pointers[idx];
-            if (node->is_leaf[idx]) {
-                string* str_ptr = static_cast<string*>(ptr);
-                auto it = tree_data.filters_map.find(*str_ptr);
-                if (it != tree_data.filters_map.end()) {
-                    out.insert(it->second.begin(), it->second.end());
+    static void collect_candidates_from_tree(const string& word, CandidateSet& candidates) {
+        thread_local vector<TraversalFrame> stack;
+        const size_t word_length = word.length();
+        const Alphabet& alphabet = tree_data_array.alphabet;
+        const int dollar_idx = alphabet.mask_code();
+
+        for (size_t offset = 0; offset + FILTER_NUMBER_OF_MATCHES <= word_length; ++offset)
+            stack.push_back({ 0, static_cast<uint16_t>(offset), 0 });
+
+        while (!stack.empty()) {
+            const TraversalFrame frame = stack.back();
+            stack.pop_back();
+
+            const size_t word_index = frame.offset + frame.depth;
+            const uint32_t* element = tree_data_array.element(frame.ref);
+            const uint8_t code = alphabet.code(word[word_index]);
+            const uint32_t branches[2] = { code != Alphabet::UNMAPPED ? element[code] : TreeArrayElement::EMPTY, element[dollar_idx] };
+
+            for (uint32_t pointer : branches) {
+                if (pointer == TreeArrayElement::EMPTY) continue;
+
+                if (TreeArrayElement::is_leaf(pointer)) {
+                    uint32_t leaf = TreeArrayElement::index_of(pointer);
+                    append_leaf_candidates(tree_data_array.leaf_begin(leaf), tree_data_array.leaf_end(leaf), frame.offset, candidates);
+                }
+                else if (word_index + 1 < word_length) {
+                    stack.push_back({ pointer, frame.offset, static_cast<uint16_t>(frame.depth + 1) });
                 }
-            }
-            else {
-                collect_positions_from_tree(static_cast<TreeNode*>(ptr), word, offset, depth + 1, out);
             }
         }
+    }
 
-        // Check $ path
-        if (node->pointers[dollar_idx]) {
-            void* ptr = node->pointers[dollar_idx];
-            if (node->is_leaf[dollar_idx]) {
-                string* str_ptr = static_cast<string*>(ptr);
-                auto it = tree_data.filters_map.find(*str_ptr);
-                if (it != tree_data.filters_map.end()) {
-                    out.insert(it->second.begin(), it->second.end());
-                }
-            }
-            else {
-                collect_positions_from_tree(static_cast<TreeNode*>(ptr), word, offset, depth + 1, out);
-            }
+    /**
+     * @brief Finds and verifies all matches of a single search word.
+     *
+     * Every alignment start is verified once, in text order, no matter through how many
+     * offsets it was reached.
+     *
+     * @param collector Function returning the candidate alignment starts of a word.
+     * @param text The text the tree was built from.
+     * @param word The search word.
+     * @param word_index Index of the word in the search list.
+     * @param candidates Reusable candidate set of the calling thread.
+     * @param hits The buffer to append the verified matches to.
+     */
+    static void search_word(CandidatesCollector collector, string_view text, const string& word, size_t word_index,
+        CandidateSet& candidates, vector<WordHit>& hits) {
+        // === Collect the alignment starts of all windows of word ===
+        // The limit is the number of windows of the text, not counting its trailing line break
+        const size_t text_size = without_line_break(text).size();
+        candidates.reset(text_size >= word.size() ? text_size - word.size() + 1 : 0);
+        collector(word, candidates);
+
+        for (TextPosition candidate : candidates.sorted()) {
+            if (check_matches(text, candidate, word))
+                hits.push_back({ word_index, candidate });
         }
     }
 
     /**
-     * @brief Retrieves all positions from the tree for a given word starting at a specific offset.
+     * @brief Searches all words on the scheduler's threads and merges the matches into `results`.
      *
-     * This function calls `collect_positions_from_tree` to recursively gather matching
-     * positions from the tree, starting at the provided offset for the given word.
+     * Every word is one task. Workers keep their matches and candidate sets private, and
+     * the matches are merged after all workers finish, in word order, so the results do
+     * not depend on the number of threads.
      *
-     * @param word The word to search for in the tree.
-     * @param offset The offset within the word to match.
-     * @param out The set to store the resulting matching positions.
+     * @param collector Function returning the candidate alignment starts of a word.
+     * @param text The text the tree was built from.
+     * @param search_words The words to search for.
+     * @param scheduler The scheduler to run the words on.
+     * @param show_progress Flag indicating if should print progress while searching.
+     * @param results The vector to append the matches to.
+     * @return size_t Number of distinct (word, position) matches added to `results`.
      */
-    inline static void get_all_positions_from_tree(const string& word, size_t offset, unordered_set<size_t>& out) {
-        collect_positions_from_tree(tree_data.tree, word, offset, 0, out);
+    static size_t search_words_in_parallel(CandidatesCollector collector, string_view text, const vector<string>& search_words,
+        WorkStealingScheduler& scheduler, bool show_progress, vector<WordMatch>& results) {
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
+        vector<CandidateSet> candidate_sets(scheduler.threads_count());
+
+        scheduler.run(search_words.size(), [&](unsigned worker, size_t word_index) {
+            search_word(collector, text, search_words[word_index], word_index, candidate_sets[worker], thread_hits[worker]);
+        }, show_progress);
+
+        return merge_word_hits(thread_hits, search_words, results);
     }
 
     /**
-     * @brief Executes the MCS Tree search algorithm.
+     * @brief Runs the tree search flow with a given positions collector.
      *
-     * This function initiates the tree search by loading the text and search words,
-     * initializing the tree data, and performing parallel searches for each word in the
-     * search list. It collects matching positions, verifies matches against the text,
-     * and stores the results. The results are then saved to an output file and a summary
-     * of the search is saved.
+     * Waits for the text and search words from `loader`, collects candidate alignment starts of every
+     * word through `collector`, verifies them against the text and saves the results and the summary.
+     * Words are searched on get_number_of_threads() threads, batch by batch as they are parsed.
      *
+     * @param loader The loader the text and search words are being read by.
+     * @param collector Function returning the candidate alignment starts of a word.
+     * @param search_type Name of the search written to the summary.
+     * @param output_filename File to save the matches to.
+     * @param summary_filename File to save the summary to.
      * @return int Status code indicating success (0) or failure (-1).
      */
-    int run_tree_mcs_search() {
-        cout << "[MCSTreeSearch] Starting MCS Tree search...\n";
-
+    int run_search_with_collector(SearchInputLoader& loader, CandidatesCollector collector, const string& search_type,
+        const string& output_filename, const string& summary_filename) {
         // Init
-        // === Load Text ===
-        string text = read_text_from_file(RANDOM_GENERATED_TEXT_FILENAME);
-        if (text.empty()) {
+        // === Wait for the text ===
+        string_view text;
+        if (loader.wait_text(text) != 0) {
             cerr << "[MCSTreeSearch] Failed to load text - it's empty or doesn't exist.\n";
             return -1;
         }
 
-        // === Load search words ===
-        vector<string> search_words = read_lines_from_file(SEARCH_WORDS_FILENAME);
-        if (search_words.empty()) {
+        // --- Prepare container to collect results ---
+        vector<string> search_words;
+        vector<WordMatch> results;
+        WorkStealingScheduler scheduler(get_number_of_threads());
+        vector<vector<WordHit>> thread_hits(scheduler.threads_count());
+        vector<CandidateSet> candidate_sets(scheduler.threads_count());
+
+        auto start = steady_clock::now();
+
+        // === Phase 2: Iterate over each search word, batch by batch as they are parsed ===
+        cout << "[MCSTreeSearch] Start iterating over search words on " << scheduler.threads_count() << " threads...\n";
+        int words_status = loader.run_word_batches(scheduler, search_words, [&](unsigned worker, size_t word_index, const string& word) {
+            search_word(collector, text, word, word_index, candidate_sets[worker], thread_hits[worker]);
+        });
+        if (words_status != 0) {
             cerr << "[MCSTreeSearch] Failed to load search words.\n";
             return -1;
         }
+        size_t count_total_finds = merge_word_hits(thread_hits, search_words, results);
 
-        int count_total_finds = 0;
+        auto end = steady_clock::now();
+        duration<double> elapsed_seconds = end - start;
+        double seconds = elapsed_seconds.count();
+        Summary summary = { search_type, count_total_finds, seconds };
+        scheduler.print_stats("[MCSTreeSearch]");
 
-        // === Phase 1: Verify tree exist and inits ===
-        if (tree_data.tree == nullptr) {
-            cerr << "[MCSTreeSearch] Failed to load tree data - it doesnt exist.\n";
+        // Save results to file
+        int status = save_results(results, search_words, search_type, without_line_break(text).size(), output_filename);
+        save_to_file(summary.to_lines(), summary_filename, true);
+
+        if (status == 0) cout << "[MCSTreeSearch] MCS search complete with total finds " << count_total_finds << ". Results saved to " << output_filename << '\n';
+        return status;
+    }
+
+    /**
+     * @brief Share of the workers' time over the scheduler's runs that was not spent on tasks.
+     */
+    static double idle_percent(const WorkStealingScheduler& scheduler) {
+        double busy = 0, idle = 0;
+        for (const WorkerStats& stats : scheduler.stats()) {
+            busy += stats.busy_seconds;
+            idle += stats.idle_seconds;
+        }
+        return busy + idle > 0 ? 100.0 * idle / (busy + idle) : 0;
+    }
+
+    /**
+     * @brief Measures the search throughput with 1 up to get_number_of_threads() threads.
+     *
+     * Every run searches all words from scratch. The report lists the time, the words per
+     * second, the speedup over one thread and the share of worker time spent idle, and
+     * flags runs whose finds differ.
+     *
+     * @param collector Function returning the candidate alignment starts of a word.
+     * @param search_type Name of the search written to the report.
+     * @param scaling_filename File to save the report to.
+     * @return int Status code indicating success (0) or failure (-1).
+     */
+    int run_search_scaling_with_collector(CandidatesCollector collector, const string& search_type, const string& scaling_filename) {
+        shared_ptr<const MappedText> cached_text;
+        shared_ptr<const vector<string>> cached_words;
+        if (DatasetCache::get_text(RANDOM_GENERATED_TEXT_FILENAME, cached_text) != 0 ||
+            DatasetCache::get_lines(SEARCH_WORDS_FILENAME, cached_words) != 0) {
+            cerr << "[MCSTreeSearch] Failed to load the text or the search words.\n";
             return -1;
         }
+        string_view text = cached_text->text;
+        const vector<string>& search_words = *cached_words;
 
-        // --- Prepare container to collect results ---
-        set<WordMatch> results;
-        size_t total_words = search_words.size();
+        unsigned max_threads = get_number_of_threads();
+        vector<string> report = { "Search Type: " + search_type, "Threads | Seconds | Words/s | Speedup | Idle" };
+        double single_thread_seconds = 0;
+        size_t single_thread_finds = 0;
+        int status = 0;
 
-        auto start = steady_clock::now();
+        cout << "[MCSTreeSearch] Measuring search scaling for 1.." << max_threads << " threads...\n";
+        for (unsigned threads_count = 1; threads_count <= max_threads; ++threads_count) {
+            vector<WordMatch> results;
+            WorkStealingScheduler scheduler(threads_count);
+            auto start = steady_clock::now();
+            size_t finds = search_words_in_parallel(collector, text, search_words, scheduler, false, results);
+            duration<double> elapsed_seconds = steady_clock::now() - start;
+            double seconds = elapsed_seconds.count();
 
-        // === Phase 2: Iterate over each search word ===
-        cout << "[MCSTreeSearch] Start iterating over search words...\n";
-        #pragma omp parallel for reduction(+:count_total_finds)
-        for (size_t word_index = 0; word_index < total_words; ++word_index) {
-            const string& word = search_words[word_index];
-            const size_t word_length = word.length();
-            
-            // === Phase 3: Scan windows of word ===
-            unordered_set<MatchPos> all_positions;
-
-            for (size_t offset = 0; offset <= word_length - FILTER_NUMBER_OF_MATCHES; ++offset) {
-                unordered_set<size_t> positions;
-                get_all_positions_from_tree(word, offset, positions);
-
-                for (size_t pos : positions) {
-                    MatchPos mp = { pos - offset, offset };
-                    all_positions.insert(mp);
-                }
+            if (threads_count == 1) {
+                single_thread_seconds = seconds;
+                single_thread_finds = finds;
             }
 
-            // Now iterate over all_positions
-            for (const MatchPos& mp : all_positions) {
-                if (mp.position + word.size() >= text.size()) continue;
-
-                if (check_matches(text, mp.position, word)) {
-                    if (insert_or_update_match(results, word, mp.position))
-                        count_total_finds++;
-                }
+            ostringstream line;
+            line << threads_count << " | " << fixed << setprecision(4) << seconds << " | "
+                 << setprecision(0) << search_words.size() / seconds << " | "
+                 << setprecision(2) << single_thread_seconds / seconds << "x | "
+                 << setprecision(1) << idle_percent(scheduler) << "%";
+            if (finds != single_thread_finds) {
+                line << " | finds differ (" << finds << " vs " << single_thread_finds << ")";
+                status = -1;
             }
 
-            print_progress(static_cast<int>(word_index), static_cast<int>(total_words));
+            cout << "[MCSTreeSearch] " << line.str() << '\n';
+            report.push_back(line.str());
         }
 
-        auto end = steady_clock::now();
-        duration<double> elapsed_seconds = end - start;
-        double seconds = elapsed_seconds.count();
-        Summary summary = { "Tree Search", count_total_finds, seconds };
+        if (save_to_file(report, scaling_filename, true) != 0) return -1;
+        return status;
+    }
+
+    /**
+     * @brief Executes the MCS Tree search algorithm.
+     *
+     * This function initiates the tree search by loading the text and search words in the background while
+     * initializing the tree data (mapping the saved tree file when no tree was built
+     * in this run), and performing parallel searches for each word in the search list. It collects matching positions, verifies matches against the text,
+     * and stores the results. The results are then saved to an output file and a summary
+     * of the search is saved.
+     *
+     * @return int Status code indicating success (0) or failure (-1).
+     */
+    int run_tree_mcs_search() {
+        cout << "[MCSTreeSearch] Starting MCS Tree search...\n";
+        SearchInputLoader loader(RANDOM_GENERATED_TEXT_FILENAME, SEARCH_WORDS_FILENAME);
 
-        vector<WordMatch> results_vector(results.begin(), results.end());
-        vector<string> output_lines = convert_matches_to_lines(results_vector);
+        // === Phase 1: Verify tree exist, or map the saved one, while the inputs load ===
+        if (tree_data_array.empty() && MCS_Tree_File::load_mcs_tree() != 0) {
+            cerr << "[MCSTreeSearch] Failed to load tree data - it doesnt exist.\n";
+            return -1;
+        }
 
-        // Save results to file
-        int status = save_to_file(output_lines, MCS_TREE_SEARCH_OUTPUT_FILENAME, true);
-        save_to_file(summary.to_lines(), MCS_TREE_SEARCH_SUMMARY_FILENAME, true);
+        return run_search_with_collector(loader, collect_candidates_from_tree, "Tree Search",
+            MCS_TREE_SEARCH_OUTPUT_FILENAME, MCS_TREE_SEARCH_SUMMARY_FILENAME);
+    }
 
-        if (status == 0) cout << "[StandardMCSSearch] MCS search complete with total finds " << count_total_finds << ". Results saved to " << MCS_TREE_SEARCH_OUTPUT_FILENAME << '\n';
-        return status;
-	}
+    /**
+     * @brief Reports the MCS Tree search throughput for 1 up to get_number_of_threads() threads.
+     *
+     * @return int Status code indicating success (0) or failure (-1).
+     */
+    int run_tree_mcs_search_scaling() {
+        cout << "[MCSTreeSearch] Starting MCS Tree search scaling...\n";
+
+        if (tree_data_array.empty() && MCS_Tree_File::load_mcs_tree() != 0) {
+            cerr << "[MCSTreeSearch] Failed to load tree data - it doesnt exist.\n";
+            return -1;
+        }
+
+        return run_search_scaling_with_collector(collect_candidates_from_tree, "Tree Search", MCS_TREE_SEARCH_SCALING_FILENAME);
+    }
 }
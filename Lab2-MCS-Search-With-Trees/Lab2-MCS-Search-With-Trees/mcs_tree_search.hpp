@@ -3,28 +3,100 @@
 
 #include "utils.hpp"
 #include "config.hpp"
-#include "TreeNode.hpp"
-#include "TreeData.hpp"
+#include "TreeArrayElement.hpp"
+#include "TreeDataArray.hpp"
 #include "create_mcs_tree.hpp"
+#include "mcs_tree_file.hpp"
+#include "result_file.hpp"
 #include <unordered_map>
-#include <unordered_set>
 #include "Summary.hpp"
+#include "CandidateSet.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "SearchInputLoader.hpp"
 #include <chrono>
-#include "MatchPos.hpp"
 
 namespace Tree_MCS_Search {
+	/**
+	 * @brief Adds the alignment start (text position minus word offset) of every tree key
+	 *        matching `word` at any offset to `candidates`.
+	 */
+	typedef void (*CandidatesCollector)(const string& word, CandidateSet& candidates);
+
+	/**
+	 * @brief Pending tree node of an iterative traversal: the node, the word offset the path
+	 *        started at and the number of key characters already matched.
+	 */
+	struct TraversalFrame {
+		uint32_t ref;
+		uint16_t offset;
+		uint16_t depth;
+	};
+
+	/**
+	 * @brief Adds the alignment starts of a leaf's text positions found at word `offset`.
+	 *
+	 * @param begin First text position of the leaf.
+	 * @param end One past the last text position of the leaf.
+	 * @param offset The word offset the key was matched at.
+	 * @param candidates The set to add to.
+	 */
+	inline void append_leaf_candidates(const Config::TextPosition* begin, const Config::TextPosition* end, size_t offset, CandidateSet& candidates) {
+		// Positions are sorted, so the ones before `offset` (no alignment start) come first
+		while (begin != end && *begin < offset) ++begin;
+		for (; begin != end; ++begin)
+			candidates.add(static_cast<Config::TextPosition>(*begin - offset));
+	}
+
+	/**
+	 * @brief Runs the tree search flow with a given positions collector.
+	 *
+	 * Waits for the text and search words from `loader`, collects candidate alignment starts of every
+	 * word through `collector`, verifies them against the text and saves the results and the summary.
+	 * Words are searched on get_number_of_threads() threads, batch by batch as they are parsed.
+	 *
+	 * @param loader The loader the text and search words are being read by.
+	 * @param collector Function returning the candidate alignment starts of a word.
+	 * @param search_type Name of the search written to the summary.
+	 * @param output_filename File to save the matches to.
+	 * @param summary_filename File to save the summary to.
+	 * @return int Status code indicating success (0) or failure (-1).
+	 */
+	int run_search_with_collector(SearchInputLoader& loader, CandidatesCollector collector, const string& search_type,
+		const string& output_filename, const string& summary_filename);
+
+	/**
+	 * @brief Measures the search throughput with 1 up to get_number_of_threads() threads.
+	 *
+	 * Every run searches all words from scratch. The report lists the time, the words per
+	 * second, the speedup over one thread and the share of worker time spent idle, and
+	 * flags runs whose finds differ.
+	 *
+	 * @param collector Function returning the candidate alignment starts of a word.
+	 * @param search_type Name of the search written to the report.
+	 * @param scaling_filename File to save the report to.
+	 * @return int Status code indicating success (0) or failure (-1).
+	 */
+	int run_search_scaling_with_collector(CandidatesCollector collector, const string& search_type, const string& scaling_filename);
+
 	/**
 	 * @brief Executes the MCS Tree search algorithm.
 	 *
-	 * This function initiates the tree search by loading the text and search words,
-	 * initializing the tree data, and performing parallel searches for each word in the
-	 * search list. It collects matching positions, verifies matches against the text,
+	 * This function initiates the tree search by loading the text and search words in the background while
+	 * initializing the tree data (mapping the saved tree file when no tree was built
+	 * in this run), and performing parallel searches for each word in the search list. It collects matching positions, verifies matches against the text,
 	 * and stores the results. The results are then saved to an output file and a summary
 	 * of the search is saved.
 	 *
 	 * @return int Status code indicating success (0) or failure (-1).
 	 */
 	int run_tree_mcs_search();
+
+	/**
+	 * @brief Reports the MCS Tree search throughput for 1 up to get_number_of_threads() threads.
+	 *
+	 * @return int Status code indicating success (0) or failure (-1).
+	 */
+	int run_tree_mcs_search_scaling();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "result_file.hpp"
+#include <cstring>
+
+using namespace std;
+using namespace Utils;
+using namespace Config;
+
+namespace ResultFile {
+
+    static_assert(sizeof(ResultFileHeader) == 128, "ResultFileHeader layout changed");
+
+    /**
+     * @brief Appends one native-endian uint64 to the writer.
+     */
+    static void write_uint64(ResultWriter& writer, uint64_t value) {
+        writer.write(string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+    }
+
+    /**
+     * @brief Appends one native-endian text position to the writer.
+     */
+    static void write_position(ResultWriter& writer, TextPosition value) {
+        writer.write(string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+    }
+
+    /**
+     * @brief Saves search results in the binary results format, and also as text when Config::SAVE_RESULTS_AS_TEXT is set.
+     *
+     * @param matches The results, sorted by word.
+     * @param search_words The search words the matches' word ids refer to.
+     * @param engine Name of the search that produced the results.
+     * @param text_size Length of the searched text, without its trailing line break.
+     * @param filename The target filename, without extension.
+     * @return int 0 on success, -1 on failure.
+     */
+    int save_results(const vector<WordMatch>& matches, const vector<string>& search_words, const string& engine, uint64_t text_size, const string& filename) {
+        string final_filename = filename + RESULT_FILE_EXTENSION;
+        cout << "[ResultFile] Saving to file: " << final_filename << "\n";
+
+        // === Size the sections ===
+        uint64_t positions_count = 0;
+        uint64_t word_chars_size = 0;
+        for (const WordMatch& match : matches) {
+            positions_count += match.positions.size();
+            word_chars_size += search_words[match.word_id].size();
+        }
+
+        ResultFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, RESULT_FILE_MAGIC, sizeof(header.magic));
+        header.version = RESULT_FILE_VERSION;
+        header.byte_order = RESULT_FILE_BYTE_ORDER;
+        engine.copy(header.engine, sizeof(header.engine) - 1);
+        header.position_size = sizeof(TextPosition);
+        header.text_size = text_size;
+        header.search_word_size = SEARCH_WORD_SIZE;
+        header.minimal_matches = MINIMAL_MATCHES;
+        header.filter_matches = FILTER_NUMBER_OF_MATCHES;
+        header.y_letter = static_cast<uint32_t>(Y_LETTER);
+        header.words_count = matches.size();
+        header.positions_count = positions_count;
+        header.word_offsets_offset = sizeof(ResultFileHeader);
+        header.position_offsets_offset = header.word_offsets_offset + (header.words_count + 1) * sizeof(uint64_t);
+        header.positions_offset = header.position_offsets_offset + (header.words_count + 1) * sizeof(uint64_t);
+        header.word_chars_offset = header.positions_offset + positions_count * sizeof(TextPosition);
+        header.word_chars_size = word_chars_size;
+
+        // === Write the header and the sections in file order ===
+        ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+        if (writer.open(final_filename, true) != 0) {
+            cerr << "[ResultFile] Failed to open file: " << final_filename << '\n';
+            return -1;
+        }
+        writer.write(string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+
+        uint64_t offset = 0;
+        write_uint64(writer, offset);
+        for (const WordMatch& match : matches) {
+            offset += search_words[match.word_id].size();
+            write_uint64(writer, offset);
+        }
+
+        offset = 0;
+        write_uint64(writer, offset);
+        for (const WordMatch& match : matches) {
+            offset += match.positions.size();
+            write_uint64(writer, offset);
+        }
+
+        for (const WordMatch& match : matches) {
+            for (TextPosition pos : match.positions) write_position(writer, pos);
+        }
+
+        for (const WordMatch& match : matches) writer.write(search_words[match.word_id]);
+
+        if (writer.close() != 0) {
+            cerr << "[ResultFile] Failed to write file: " << final_filename << '\n';
+            return -1;
+        }
+        cout << "[ResultFile] File saved successfully: " << final_filename << " (" << matches.size() << " words)\n";
+
+        if (SAVE_RESULTS_AS_TEXT) return save_matches_to_file(matches, search_words, filename, true);
+        return 0;
+    }
+
+    /**
+     * @brief Returns why a mapped results file cannot be read, or nullptr if it is valid.
+     */
+    static const char* validate(const MappedFile& file, const ResultFileHeader& header) {
+        if (memcmp(header.magic, RESULT_FILE_MAGIC, sizeof(header.magic)) != 0) return "not a results file";
+        if (header.version != RESULT_FILE_VERSION) return "unsupported version";
+        if (header.byte_order != RESULT_FILE_BYTE_ORDER) return "written on a machine with a different byte order";
+        if (header.position_size != sizeof(uint32_t) && header.position_size != sizeof(uint64_t)) return "unsupported position size";
+        // The counts and offsets are bounded by the file size first, so the section ends below cannot overflow
+        if (header.words_count >= file.size() / sizeof(uint64_t) || header.positions_count > file.size() / header.position_size ||
+            header.word_chars_size > file.size() || header.word_offsets_offset > file.size() ||
+            header.position_offsets_offset > file.size() || header.positions_offset > file.size() || header.word_chars_offset > file.size() ||
+            header.word_offsets_offset % alignof(uint64_t) != 0 || header.position_offsets_offset % alignof(uint64_t) != 0 ||
+            header.word_offsets_offset + (header.words_count + 1) * sizeof(uint64_t) > file.size() ||
+            header.position_offsets_offset + (header.words_count + 1) * sizeof(uint64_t) > file.size() ||
+            header.positions_offset + header.positions_count * header.position_size > file.size() ||
+            header.word_chars_offset + header.word_chars_size > file.size()) return "sections are out of bounds";
+
+        const uint64_t* word_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.word_offsets_offset);
+        const uint64_t* position_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.position_offsets_offset);
+        for (uint64_t i = 0; i < header.words_count; ++i) {
+            if (word_offsets[i] > word_offsets[i + 1] || position_offsets[i] > position_offsets[i + 1]) return "offsets are corrupted";
+        }
+        if (word_offsets[header.words_count] != header.word_chars_size ||
+            position_offsets[header.words_count] != header.positions_count) return "offsets are corrupted";
+        return nullptr;
+    }
+
+    /**
+     * @brief Maps a binary results file and checks its header and section offsets.
+     *
+     * @param filename The results filename, without extension (reads .bin).
+     * @param file The mapping to open; the sections point into it.
+     * @param header Set to the header of the file, with a null-terminated engine name.
+     * @return int 0 on success, -1 if the file is missing, truncated or corrupted.
+     */
+    int map_results(const string& filename, MappedFile& file, ResultFileHeader& header) {
+        string binary_filename = filename + RESULT_FILE_EXTENSION;
+
+        if (file.open(binary_filename, MappedFile::Access::SEQUENTIAL) != 0) {
+            cerr << "[ResultFile] Failed to map file: " << binary_filename << '\n';
+            return -1;
+        }
+
+        if (file.size() < sizeof(header)) {
+            cerr << "[ResultFile] Results file is truncated: " << binary_filename << '\n';
+            return -1;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+
+        const char* problem = validate(file, header);
+        if (problem != nullptr) {
+            cerr << "[ResultFile] Results file rejected - " << problem << ": " << binary_filename << '\n';
+            return -1;
+        }
+
+        header.engine[sizeof(header.engine) - 1] = '\0';
+        return 0;
+    }
+
+    /**
+     * @brief Returns the position at `index` of the positions section of a mapped results file.
+     *
+     * @param file The mapped results file.
+     * @param header The header of the file, as returned by map_results().
+     * @param index Index of the position, below header.positions_count.
+     * @return uint64_t The text position, whatever the position size of the file.
+     */
+    uint64_t read_position(const MappedFile& file, const ResultFileHeader& header, uint64_t index) {
+        const char* position = file.data() + header.positions_offset + index * header.position_size;
+        if (header.position_size == sizeof(uint32_t)) {
+            uint32_t value;
+            memcpy(&value, position, sizeof(value));
+            return value;
+        }
+
+        uint64_t value;
+        memcpy(&value, position, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Converts a binary results file into the "Word: / Positions:" text format.
+     *
+     * @param filename The results filename, without extension (reads .bin, writes .txt).
+     * @return int 0 on success, -1 on failure.
+     */
+    int convert_results_to_text(const string& filename) {
+        string binary_filename = filename + RESULT_FILE_EXTENSION;
+
+        MappedFile file;
+        ResultFileHeader header;
+        if (map_results(filename, file, header) != 0) return -1;
+
+        cout << "[ResultFile] Converting " << binary_filename << " (" << header.engine << ", "
+             << header.words_count << " words, " << header.positions_count << " positions)\n";
+
+        ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+        if (open_result_file(writer, filename, true) != 0) return -1;
+
+        const uint64_t* word_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.word_offsets_offset);
+        const uint64_t* position_offsets = reinterpret_cast<const uint64_t*>(file.data() + header.position_offsets_offset);
+        const char* word_chars = file.data() + header.word_chars_offset;
+
+        size_t total = static_cast<size_t>(header.words_count);
+        Telemetry::ProgressCounter progress("Converting results", total);
+        for (size_t i = 0; i < total; ++i) {
+            writer.write("Word: ");
+            writer.write(string_view(word_chars + word_offsets[i], static_cast<size_t>(word_offsets[i + 1] - word_offsets[i])));
+            writer.write("\nPositions: ");
+            for (uint64_t p = position_offsets[i]; p < position_offsets[i + 1]; ++p) {
+                if (p != position_offsets[i]) writer.write(", ");
+                writer.write_number(read_position(file, header, p));
+            }
+            writer.write("\n\n");
+
+            progress.set(i + 1);
+        }
+        progress.finish();
+
+        if (writer.close() != 0) {
+            cerr << "[ResultFile] Failed to write the text results of " << binary_filename << '\n';
+            return -1;
+        }
+        cout << "[ResultFile] Text results saved to " << filename << ".txt\n";
+        return 0;
+    }
+
+    /**
+     * @brief Converts every binary search results file listed in Config::SEARCH_OUTPUT_FILENAMES that exists.
+     *
+     * @return int 0 on success, -1 if no file was found or a conversion failed.
+     */
+    int run_results_conversion() {
+        int converted = 0;
+        int failed = 0;
+        for (const string& filename : SEARCH_OUTPUT_FILENAMES) {
+            if (!ifstream(filename + RESULT_FILE_EXTENSION).good()) continue;
+
+            if (convert_results_to_text(filename) == 0) converted++;
+            else failed++;
+        }
+
+        if (converted == 0 && failed == 0) {
+            cerr << "[ResultFile] No binary results found - run a search first.\n";
+            return -1;
+        }
+
+        cout << "[ResultFile] Converted " << converted << " results file(s) to text.\n";
+        return failed == 0 ? 0 : -1;
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+
+namespace Telemetry {
+
+    /**
+     * @brief Shared state of one progress counter, owned by its ProgressCounter and the registry.
+     */
+    struct CounterState {
+        std::string name;
+        uint64_t total = 0;
+        std::atomic<uint64_t> done{ 0 };
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;  // Set once finished
+        bool finished = false;                      // Guarded by the registry mutex
+    };
+
+    /**
+     * @brief Point-in-time copy of a counter, as returned by snapshot_counters().
+     */
+    struct CounterSnapshot {
+        std::string name;
+        uint64_t done;
+        uint64_t total;
+        double elapsed_seconds;
+        double items_per_second;
+        double eta_seconds;                         // 0 once finished, negative while no rate is known
+        bool finished;
+    };
+
+    /**
+     * @brief Progress counter of one loop, rendered by the background reporter thread.
+     *
+     * Hot loops only bump the counter with a relaxed atomic add() or set(). A reporter thread,
+     * running while any counter is active, prints the progress, rate and ETA of all active
+     * counters every Config::PROGRESS_REPORT_INTERVAL_MS milliseconds. The counter finishes
+     * when finish() is called or it goes out of scope, printing its final line.
+     */
+    class ProgressCounter {
+    public:
+        /**
+         * @param name Name shown in the progress line and the snapshots.
+         * @param total Number of items the loop will process.
+         */
+        ProgressCounter(const std::string& name, uint64_t total);
+        ~ProgressCounter();
+
+        ProgressCounter(const ProgressCounter&) = delete;
+        ProgressCounter& operator=(const ProgressCounter&) = delete;
+
+        /**
+         * @brief Counts `count` more processed items. Safe to call from any thread.
+         */
+        void add(uint64_t count = 1) { state->done.fetch_add(count, std::memory_order_relaxed); }
+
+        /**
+         * @brief Sets the number of processed items, for single-threaded loops that know their index.
+         */
+        void set(uint64_t done) { state->done.store(done, std::memory_order_relaxed); }
+
+        /**
+         * @brief Stops counting and prints the final progress line. Called by the destructor if not before.
+         */
+        void finish();
+
+    private:
+        std::shared_ptr<CounterState> state;
+    };
+
+    /**
+     * @brief Returns the active counters and the most recently finished ones, oldest first.
+     *
+     * @return std::vector<CounterSnapshot> One snapshot per counter.
+     */
+    std::vector<CounterSnapshot> snapshot_counters();
+}
+
+#endif
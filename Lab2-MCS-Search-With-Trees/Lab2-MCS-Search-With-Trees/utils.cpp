@@ -1,4 +1,6 @@
 #include "utils.hpp"
+#include "dataset_cache.hpp"
+#include <limits>
 
 using namespace std;
 using namespace chrono;
@@ -12,7 +14,7 @@ namespace Utils {
      * @param filename The original filename
      * @return string Modified filename with .txt if missing
      */
-    static string ensure_txt_extension(const string& filename) {
+    string ensure_txt_extension(const string& filename) {
         if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
             return filename + ".txt";
         }
@@ -30,6 +32,26 @@ namespace Utils {
         return infile.good();
     }
 
+    /**
+     * @brief Asks the user before replacing an existing file, unless overwriting is allowed.
+     *
+     * @param final_filename The target filename (with extension).
+     * @param overwrite Should overwrite a file that exists or not.
+     * @return true if the file may be written, false if the user cancelled.
+     */
+    static bool confirm_overwrite(const string& final_filename, bool overwrite) {
+        if (overwrite || !file_exists(final_filename)) return true;
+
+        cout << "[Utils] File already exists. Overwrite? (y/n): ";
+        char choice = 'n';
+        cin >> choice;
+        if (choice != 'y' && choice != 'Y') {
+            cout << "[Utils] Save cancelled by user.\n";
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Handles an operation, enforcing dependencies and tracking progress flags.
      *
@@ -44,6 +66,12 @@ namespace Utils {
      *               - 3: Search Words Creation
      *               - 4: MCS Tree Creation
      *               - 5: MCS Tree Search
+     *               - 6: Adaptive MCS Tree Creation
+     *               - 7: Adaptive MCS Tree Search
+     *               - 8: MCS Tree Search Scaling
+     *               - 9: Convert Results To Text
+     *               - 10: Validate Results Against Ground Truth
+     *               - 11: Corpus Ingestion
      *
      */
     void handle_operation(int (*operation)(), int choice) {
@@ -78,15 +106,10 @@ namespace Utils {
         string final_filename = ensure_txt_extension(filename);
         cout << "[Utils] Saving to file: " << final_filename << "\n";
 
-        if (!overwrite && file_exists(final_filename)) {
-            cout << "[Utils] File already exists. Overwrite? (y/n): ";
-            char choice = 'n';
-            cin >> choice;
-            if (choice != 'y' && choice != 'Y') {
-                cout << "[Utils] Save cancelled by user.\n";
-                return -2;
-            }
-        }
+        if (!confirm_overwrite(final_filename, overwrite)) return -2;
+
+        // Drop the cached contents first, a cached text is still mapped from the file
+        DatasetCache::invalidate(final_filename);
 
         // Open file for writing
         ofstream out(final_filename);
@@ -105,135 +128,219 @@ namespace Utils {
     }
 
     /**
-     * @brief Reads full text content from a file.
+     * @brief Maps a text file into memory and exposes it as a read-only view.
+     *
+     * A file longer than the largest Config::TextPosition is rejected, so every position in
+     * it can be stored and cast to a TextPosition without being truncated.
      *
      * @param filename The input filename
+     * @param mapped The mapped text to fill (empty on failure)
      * @param should_print_log Flag indicating if should print logs.
-     * @return string The content read from the file, or empty on failure
+     * @param prefault Flag indicating if all pages should be read in now, on the calling thread.
+     * @return int 0 on success, -1 on failure (missing, empty or too long file)
      */
-    string read_text_from_file(const string& filename, bool should_print_log) {
+    int map_text_from_file(const string& filename, MappedText& mapped, bool should_print_log, bool prefault) {
         // Ensure filename ends with .txt
         string final_filename = ensure_txt_extension(filename);
 
-        // Open file for reading
-        ifstream in(final_filename, ios::binary);
-        if (!in) {
+        mapped.text = string_view();
+        if (mapped.file.open(final_filename, MappedFile::Access::SEQUENTIAL, prefault) != 0) {
             if (should_print_log) cerr << "[Utils] Failed to open file: " << final_filename << '\n';
-            return "";
+            return -1;
         }
 
-        in.clear(); // reset any flags
-        in.seekg(0, ios::beg); // ensure we're at the start
+        if (mapped.file.size() > numeric_limits<TextPosition>::max()) {
+            cerr << "[Utils] File is too long for " << sizeof(TextPosition) * 8 << "-bit text positions - raise TEXT_SIZE: " << final_filename << '\n';
+            mapped.file.close();
+            return -1;
+        }
 
-        // Read full content into buffer
-        stringstream buffer;
-        buffer << in.rdbuf();
+        mapped.text = string_view(mapped.file.data(), mapped.file.size());
+        if (should_print_log) cout << "[Utils] Loaded text from file: " << final_filename << '\n';
+        return 0;
+    }
 
-        cout << "[Utils] Loaded text from file: " << final_filename << '\n';
-        return buffer.str();
+    /**
+     * @brief Returns the text without the line break a text file ends with.
+     *
+     * @param text The contents of a text file.
+     * @return string_view The text up to its trailing newline and carriage return characters.
+     */
+    string_view without_line_break(string_view text) {
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.remove_suffix(1);
+        return text;
     }
 
     /**
-     * @brief Reads a newline-separated list of strings from a file.
+     * @brief Maps a newline-separated file into memory and slices it into line views.
+     *
+     * Empty lines are skipped and trailing carriage returns are removed, like read_lines_from_file.
      *
      * @param filename Name of the file to read.
-     * @param should_print_log Flag indicating if should print logs. Default to true.
-     * @return vector<string> List of lines (words).
+     * @param mapped The mapped lines to fill (no lines on failure)
+     * @param should_print_log Flag indicating if should print logs.
+     * @return int 0 on success, -1 on failure (missing or empty file)
      */
-    vector<string> read_lines_from_file(const string& filename, bool should_print_log) {
-        vector<string> lines;
-        string content = read_text_from_file(filename, should_print_log);
-        if (content.empty()) return lines;
+    int map_lines_from_file(const string& filename, MappedLines& mapped, bool should_print_log) {
+        mapped.lines.clear();
+
+        MappedText content;
+        if (map_text_from_file(filename, content, should_print_log) != 0) return -1;
+
+        string_view text = content.text;
+        while (!text.empty()) {
+            size_t line_end = text.find('\n');
+            string_view line = text.substr(0, line_end);
+            text = line_end == string_view::npos ? string_view() : text.substr(line_end + 1);
 
-        stringstream ss(content);
-        string line;
-        while (getline(ss, line)) {
             // Remove trailing carriage return if present
             if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
+                line.remove_suffix(1);
             }
 
             if (!line.empty()) {
-                lines.push_back(line);
+                mapped.lines.push_back(line);
             }
         }
-        return lines;
+
+        // The views point into the mapping, so it moves into `mapped` together with them
+        mapped.file = move(content.file);
+        return 0;
     }
 
     /**
-     * @brief Converts WordMatch results into printable lines for file saving.
+     * @brief Reads full text content from a file.
      *
-     * @param matches Vector of WordMatch objects
-     * @return vector<string> Formatted output lines
+     * @param filename The input filename
+     * @param should_print_log Flag indicating if should print logs.
+     * @return string The content read from the file, or empty on failure
      */
-    vector<string> convert_matches_to_lines(const vector<WordMatch>& matches) {
-        std::cout << "[Utils] Converting matches to output lines...\n";
-
-        vector<string> lines;
-        size_t total = matches.size();
+    string read_text_from_file(const string& filename, bool should_print_log) {
+        MappedText mapped;
+        if (map_text_from_file(filename, mapped, should_print_log) != 0) return "";
 
-        // Process each match object
-        for (size_t i = 0; i < total; ++i) {
-            const auto& match = matches[i];
-            lines.push_back(match.to_string() + "\n");
+        // Single copy, straight from the mapped pages
+        return string(mapped.text);
+    }
 
-            print_progress(static_cast<int>(i), static_cast<int>(total));
-        }
+    /**
+     * @brief Reads a newline-separated list of strings from a file.
+     *
+     * @param filename Name of the file to read.
+     * @param should_print_log Flag indicating if should print logs.
+     * @return vector<string> List of lines (words).
+     */
+    vector<string> read_lines_from_file(const string& filename, bool should_print_log) {
+        MappedLines mapped;
+        if (map_lines_from_file(filename, mapped, should_print_log) != 0) return {};
 
-        std::cout << "[Utils] Conversion complete. Total words: " << matches.size() << '\n';
-        return lines;
+        return vector<string>(mapped.lines.begin(), mapped.lines.end());
     }
 
     /**
-     * @brief Prints progress as a percentage with two decimal digits, in-place on the same line.
-     *        Progress updates are throttled to avoid excessive output.
+     * @brief Opens a results file for streaming, with the same naming and overwrite rules as save_to_file.
      *
-     * @param current Current iteration (0-based).
-     * @param total Total number of iterations (must be > 0).
+     * @param writer The writer to open.
+     * @param filename The target filename
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
      */
-    void print_progress(int current, int total) {
-        if (total <= 0) return;
+    int open_result_file(ResultWriter& writer, const string& filename, bool overwrite) {
+        string final_filename = ensure_txt_extension(filename);
+        cout << "[Utils] Saving to file: " << final_filename << "\n";
 
-        const int update_interval = max(1, total / PROGRESS_UPDATES_COUNT);
-        if (current % update_interval != 0 && current != total - 1) return;
+        if (!confirm_overwrite(final_filename, overwrite)) return -2;
 
-        double percent = (static_cast<double>(current + 1) / total) * 100.0;
-        if (percent > 100.0) percent = 100.0;
+        DatasetCache::invalidate(final_filename);
+        if (writer.open(final_filename) != 0) {
+            cerr << "[Utils] Failed to open file: " << final_filename << '\n';
+            return -1;
+        }
+        return 0;
+    }
 
-        ostringstream out;
-        out << "\r[Progress] " << fixed << setprecision(2) << percent << "%";
-        cout << out.str() << flush;
+    /**
+     * @brief Creates a file of a known size and maps it for writing, with the same naming and overwrite rules as save_to_file.
+     *
+     * @param output The output mapping to create.
+     * @param filename The target filename
+     * @param size The size of the file in bytes.
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
+     */
+    int create_mapped_output(MappedOutputFile& output, const string& filename, size_t size, bool overwrite) {
+        string final_filename = ensure_txt_extension(filename);
+        cout << "[Utils] Saving to file: " << final_filename << "\n";
+
+        if (!confirm_overwrite(final_filename, overwrite)) return -2;
 
-        // Print newline only when reaching 100%
-        if (percent >= 100.0) cout << endl;
+        DatasetCache::invalidate(final_filename);
+        if (output.create(final_filename, size) != 0) {
+            cerr << "[Utils] Failed to create file: " << final_filename << '\n';
+            return -1;
+        }
+        return 0;
     }
 
     /**
-     * @brief Inserts a WordMatch into the set, or updates the existing match with a new position.
+     * @brief Streams WordMatch results to a file, formatting them straight into the writer's buffers.
      *
-     * @param result_set Reference to the set of WordMatch entries.
-     * @param word The word being matched.
-     * @param pos The position to add to the word's match list.
-     * @return true if the position was added successfully, false if it already existed.
+     * @param matches Vector of WordMatch objects
+     * @param words The words the matches' word ids refer to.
+     * @param filename The target filename
+     * @param overwrite Should overwrite a file that exists or not, default to false.
+     * @return int 0 on success, -1 on failure, -2 if the user cancelled
      */
-    bool insert_or_update_match(set<WordMatch>& result_set, const string& word, size_t pos) {
-        WordMatch match{ word, { pos } };
-        auto insert_result = result_set.insert(match);
+    int save_matches_to_file(const vector<WordMatch>& matches, const vector<string>& words, const string& filename, bool overwrite) {
+        string final_filename = ensure_txt_extension(filename);
+        ResultWriter writer(RESULT_WRITER_BUFFER_SIZE, RESULT_WRITER_BACKGROUND);
+        int status = open_result_file(writer, final_filename, overwrite);
+        if (status != 0) return status;
 
-        if (insert_result.second) {
-            // Successfully inserted new match with pos
-            return true;
+        size_t total = matches.size();
+        Telemetry::ProgressCounter progress("Saving results", total);
+        for (size_t i = 0; i < total; ++i) {
+            writer.write_match(words[matches[i].word_id], matches[i].positions);
+            progress.set(i + 1);
         }
-        else {
-            WordMatch updated = *insert_result.first;
-            if (updated.positions.count(pos)) {
-                // Position already exists
-                return false;
-            }
-            result_set.erase(insert_result.first);
-            updated.positions.insert(pos);
-            result_set.insert(updated);
-            return true;
+        progress.finish();
+
+        if (writer.close() != 0) {
+            cerr << "[Utils] Failed to write file: " << final_filename << '\n';
+            return -1;
         }
+
+        cout << "[Utils] File saved successfully: " << final_filename << " (" << total << " words)\n";
+        return 0;
+    }
+
+    /**
+     * @brief Returns the number of worker threads to use - NUMBER_OF_THREADS, or all hardware threads when it is 0.
+     *
+     * @return unsigned Number of threads (at least 1).
+     */
+    unsigned get_number_of_threads() {
+        if (NUMBER_OF_THREADS > 0) return NUMBER_OF_THREADS;
+        return max(1u, thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Merges per-thread hit buffers into the results, in word order with sorted positions.
+     *
+     * Hits are accumulated per word id and sorted once per word, on as many threads as there
+     * are buffers. The results and the returned count are the same for any number of threads.
+     * The buffers are emptied.
+     *
+     * @param thread_hits Hit buffers of all worker threads.
+     * @param search_words The search words the hits' word indices refer to.
+     * @param results The vector to append the matches to (one WordMatch per distinct word).
+     * @return size_t Number of distinct (word, position) matches.
+     */
+    size_t merge_word_hits(vector<vector<WordHit>>& thread_hits, const vector<string>& search_words, vector<WordMatch>& results) {
+        MatchAccumulator accumulator(search_words);
+        for (vector<WordHit>& buffer : thread_hits)
+            accumulator.add_hits(buffer);
+
+        return accumulator.finish(static_cast<unsigned>(max<size_t>(1, thread_hits.size())), results);
     }
-}
\ No newline at end of file
+}